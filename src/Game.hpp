@@ -1,8 +1,8 @@
 #pragma once
 
 #include "SDL_mixer.h"
+#include "ai/InfluenceMap.hpp"
 #include "components/Patrol.hpp"
-#include "components/Projectile.hpp"
 #include "constants.hpp"
 #include "engine/Engine.hpp"
 #include "entities/item.hpp"
@@ -10,11 +10,17 @@
 #include "entities/player.hpp"
 #include "entities/projectile.hpp"
 #include "entities/sign.hpp"
+#include "map/FogOfWar.hpp"
 #include "map/MapManager.hpp"
 #include "modules/BTManager.hpp"
 #include "modules/Camera.hpp"
+#include "modules/CommandBuffer.hpp"
+#include "modules/EntityHandle.hpp"
+#include "modules/Events.hpp"
 #include "modules/GameStateManager.hpp"
+#include "modules/ProjectilePool.hpp"
 #include "modules/SaveGameManager.hpp"
+#include "modules/ThreadPool.hpp"
 #include "systems/AISystem.hpp"
 #include "systems/AnimationSystem.hpp"
 #include "systems/AudioSystem.hpp"
@@ -22,6 +28,7 @@
 #include "systems/DamageSystem.hpp"
 #include "systems/DebugSystem.hpp"
 #include "systems/FiringSystem.hpp"
+#include "systems/FogOfWarSystem.hpp"
 #include "systems/InputSystem.hpp"
 #include "systems/PathfindingSystem.hpp"
 #include "systems/PhysicsSystem.hpp"
@@ -46,7 +53,13 @@ class Game : public Engine {
 
 	bool onStart() override
 	{
+		// decoded in the background while the map and the systems are loaded
+		getAudioDevice().getSoundBank().preload(SOUND_BANK_EFFECTS, SOUND_BANK_MUSIC);
 		mapManager.loadMap(0);
+		fogOfWar.reset(mapManager.getLevelMap().getWidth(), mapManager.getLevelMap().getHeight());
+		influenceMap.reset(mapManager.getLevelMap().getWidth(), mapManager.getLevelMap().getHeight());
+		projectiles.clear();
+		events.clear();
 		initializeSystems();
 		return true;
 	}
@@ -69,12 +82,13 @@ class Game : public Engine {
 				if (!menuStack.isEmpty())
 					menuStack.reset();
 				else
-					menuStack.push(
-					    std::make_unique<InGameMenu>(*this, ecs, gameStateManager, saveGameManager, menuStack));
+					menuStack.push(std::make_unique<InGameMenu>(*this, ecs, gameStateManager, saveGameManager, menuStack,
+					                                            commandBuffer));
 			}
 
 			if (!addedEntities) {
 				addTestEntities();
+				queries.rebuild(); // the level is spawned directly into the ECS
 				addedEntities = true;
 				camera.focus(ecs.getComponent<Positionable>(PLAYER).position);
 			}
@@ -84,7 +98,11 @@ class Game : public Engine {
 			pathfindingSystem->update(ecs, deltaTime);
 			firingSystem->update(ecs, deltaTime);
 			physicsSystem->update(ecs, deltaTime);
+			events.sounds.publish(); // sync point: heard by the audio now and by the AI perception next frame
+			events.damage.publish(); // sync point: includes the projectile hits of the last frame
 			damageSystem->update(ecs, deltaTime);
+			commandBuffer.playback(ecs); // sync point: targets of the simulation
+			fogOfWarSystem->update(ecs, deltaTime);
 
 			// camera.focus(ecs.getComponent<Positionable>(PLAYER).position);
 
@@ -101,7 +119,9 @@ class Game : public Engine {
 			debugSystem->update(ecs, deltaTime);
 			projectileSystem->update(ecs, deltaTime);
 
+			events.destroy.publish(); // sync point: entities which died this frame
 			cleanupSystem->update(ecs, deltaTime);
+			commandBuffer.playback(ecs); // sync point: removes the dead entities
 
 			// TODO: render selection rectangle and entities in render system.
 			renderSelectionRectangle();
@@ -123,18 +143,20 @@ class Game : public Engine {
   private:
 	void initializeSystems()
 	{
-		inputSystem = std::make_unique<InputSystem>(*this, camera);
-		aiSystem = std::make_unique<AISystem>(btManager, mapManager);
-		physicsSystem = std::make_unique<PhysicsSystem>(mapManager);
-		renderSystem = std::make_unique<RenderSystem>(*this, mapManager, camera);
-		audioSystem = std::make_unique<AudioSystem>(*this, camera);
-		debugSystem = std::make_unique<DebugSystem>(*this, mapManager, camera);
-		pathfindingSystem = std::make_unique<PathfindingSystem>(mapManager);
-		projectileSystem = std::make_unique<ProjectileSystem>(mapManager);
-		firingSystem = std::make_unique<FiringSystem>(*this);
-		animationSystem = std::make_unique<AnimationSystem>(*this, mapManager, camera);
-		damageSystem = std::make_unique<DamageSystem>();
-		cleanupSystem = std::make_unique<CleanupSystem>();
+		inputSystem = std::make_unique<InputSystem>(*this, camera, generations);
+		aiSystem = std::make_unique<AISystem>(btManager, mapManager, threadPool, influenceMap, events);
+		physicsSystem = std::make_unique<PhysicsSystem>(mapManager, events, queries);
+		renderSystem = std::make_unique<RenderSystem>(*this, mapManager, camera, fogOfWar, projectiles, queries);
+		audioSystem = std::make_unique<AudioSystem>(*this, camera, events);
+		debugSystem = std::make_unique<DebugSystem>(*this, mapManager, camera, queries);
+		pathfindingSystem = std::make_unique<PathfindingSystem>(mapManager, queries);
+		projectileSystem = std::make_unique<ProjectileSystem>(mapManager, projectiles, events, queries);
+		firingSystem =
+		    std::make_unique<FiringSystem>(mapManager, projectiles, events, commandBuffer, generations, queries);
+		animationSystem = std::make_unique<AnimationSystem>(*this, mapManager, camera, queries);
+		damageSystem = std::make_unique<DamageSystem>(events);
+		cleanupSystem = std::make_unique<CleanupSystem>(events, commandBuffer, btManager);
+		fogOfWarSystem = std::make_unique<FogOfWarSystem>(mapManager, fogOfWar);
 	}
 
 	void createTestEntity(const Vec2i &position, const std::vector<PatrolPoint> &waypoints)
@@ -204,12 +226,20 @@ class Game : public Engine {
 	}
 
 	Easys::ECS ecs;
+	QueryRegistry queries{ecs};
+	EntityGenerations generations;                     // invalidates handles of removed entities, see EntityHandle
+	CommandBuffer commandBuffer{queries, generations}; // structural changes recorded by systems, see onUpdate
 	MapManager mapManager;
-	BTManager btManager = BTManager(ecs);
-	SaveGameManager saveGameManager = SaveGameManager(ecs);
+	FogOfWar fogOfWar;
+	InfluenceMap influenceMap;
+	ProjectilePool projectiles; // projectiles are not entities, see ProjectilePool
+	Events events;              // damage, sounds and removals passed between systems, see the sync points in onUpdate
+	BTManager btManager = BTManager(ecs, generations);
+	SaveGameManager saveGameManager = SaveGameManager(ecs, queries, generations, projectiles, events);
 	GameStateManager gameStateManager;
 	MenuStack menuStack;
 	Camera camera;
+	ThreadPool threadPool;
 	bool addedEntities = false;
 
 	std::unique_ptr<InputSystem> inputSystem;
@@ -224,4 +254,5 @@ class Game : public Engine {
 	std::unique_ptr<AnimationSystem> animationSystem;
 	std::unique_ptr<DamageSystem> damageSystem;
 	std::unique_ptr<CleanupSystem> cleanupSystem;
+	std::unique_ptr<FogOfWarSystem> fogOfWarSystem;
 };
\ No newline at end of file
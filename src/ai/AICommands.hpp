@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../components/Pathfinding.hpp"
+#include "../components/Patrol.hpp"
+#include "../components/Rotatable.hpp"
+#include "../components/Target.hpp"
+#include "../constants.hpp"
+#include "../engine/types/Vec2i.hpp"
+#include "../modules/EntityHandle.hpp"
+#include <cstddef>
+#include <easys/easys.hpp>
+#include <variant>
+#include <vector>
+
+// ECS writes of behavior tree nodes.
+//
+// Trees are ticked on several threads (see AISystem), so nodes only read the ECS and record their writes here. Every
+// thread has its own list, which is applied on the main thread once all trees are ticked. Nodes only write components
+// of their own entity, so the result does not depend on which thread ticked which tree.
+class AICommands {
+  public:
+	void setTarget(const Easys::Entity entity, const EntityHandle &target)
+	{
+		commands.push_back(SetTarget{entity, target});
+	}
+
+	void setPathTarget(const Easys::Entity entity, const Vec2i &position)
+	{
+		commands.push_back(SetPathTarget{entity, position});
+	}
+
+	void setRotation(const Easys::Entity entity, const Rotation rotation)
+	{
+		commands.push_back(SetRotation{entity, rotation});
+	}
+
+	void setPatrolIndex(const Easys::Entity entity, const int index)
+	{
+		commands.push_back(SetPatrolIndex{entity, index});
+	}
+
+	// Applies the commands in the order they were recorded and clears the list.
+	void apply(Easys::ECS &ecs)
+	{
+		for (const Command &command : commands) {
+			std::visit([&ecs](const auto &c) { applyCommand(ecs, c); }, command);
+		}
+		commands.clear();
+	}
+
+	bool empty() const { return commands.empty(); }
+	std::size_t size() const { return commands.size(); }
+
+  private:
+	struct SetTarget {
+		Easys::Entity entity;
+		EntityHandle target;
+	};
+
+	struct SetPathTarget {
+		Easys::Entity entity;
+		Vec2i position;
+	};
+
+	struct SetRotation {
+		Easys::Entity entity;
+		Rotation rotation;
+	};
+
+	struct SetPatrolIndex {
+		Easys::Entity entity;
+		int index;
+	};
+
+	using Command = std::variant<SetTarget, SetPathTarget, SetRotation, SetPatrolIndex>;
+
+	static void applyCommand(Easys::ECS &ecs, const SetTarget &command)
+	{
+		ecs.addComponent<Target>(command.entity, Target{command.target});
+	}
+
+	static void applyCommand(Easys::ECS &ecs, const SetPathTarget &command)
+	{
+		ecs.getComponent<Pathfinding>(command.entity).targetPosition = command.position;
+	}
+
+	static void applyCommand(Easys::ECS &ecs, const SetRotation &command)
+	{
+		ecs.getComponent<Rotatable>(command.entity).rotation = command.rotation;
+	}
+
+	static void applyCommand(Easys::ECS &ecs, const SetPatrolIndex &command)
+	{
+		ecs.getComponent<Patrol>(command.entity).patrolIndex = command.index;
+	}
+
+	std::vector<Command> commands; // reused every frame to avoid reallocations
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "../components/AI.hpp"
+#include "../components/Controllable.hpp"
+#include "../components/Positionable.hpp"
+#include "../constants.hpp"
+#include "../modules/ThreadPool.hpp"
+#include "AIState.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <easys/easys.hpp>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// Decides which behavior trees get ticked in a frame (AI level of detail).
+//
+// Every AI entity has a tick interval, which is the larger of an interval by state and one by distance to the closest
+// unit of the player's squad. Engaging and fleeing AIs are ticked every frame. The others are ticked once their
+// interval has passed and get the time accumulated since their last tick as deltaTime.
+//
+// New entities start at a different phase of their interval (golden ratio sequence), so entities created together do
+// not all tick in the same frame. Due ticks are run most overdue first until the frame budget is used up. The rest
+// stays due and is ticked first in one of the next frames. The budget is wall clock time, so which ticks are deferred
+// depends on the machine's load. Runs which have to be reproducible (see CombatSimulator) use UNLIMITED_BUDGET.
+class AIScheduler {
+  public:
+	static constexpr double FRAME_BUDGET = 0.002; // in seconds
+	static constexpr double UNLIMITED_BUDGET = std::numeric_limits<double>::infinity();
+	static constexpr std::size_t PARALLEL_BATCH_SIZE = 64; // ticks between two budget checks when running in parallel
+
+	explicit AIScheduler(const double frameBudget_ = FRAME_BUDGET) : frameBudget(frameBudget_) {}
+
+	// Calls tick(entity, elapsedTime) for every AI entity which is due this frame.
+	template <typename TickFunction>
+	void run(Easys::ECS &ecs, const double deltaTime, TickFunction &&tick)
+	{
+		gatherDueTicks(ecs, deltaTime);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (const DueTick &due : dueTicks) {
+			if (!due.isRequired() && isBudgetUsedUp(start)) {
+				break;
+			}
+
+			tick(due.entity, due.elapsed);
+			completeTick(due.entity);
+		}
+
+		removeDeadEntities(ecs);
+	}
+
+	// Same as above, but the ticks are split across the threads of pool and tick gets the thread index as third
+	// argument. Entities ticked every frame run as one batch, the others in batches of PARALLEL_BATCH_SIZE until the
+	// budget is used up.
+	template <typename TickFunction>
+	void run(Easys::ECS &ecs, const double deltaTime, ThreadPool &pool, TickFunction &&tick)
+	{
+		gatherDueTicks(ecs, deltaTime);
+
+		const auto start = std::chrono::steady_clock::now();
+		std::size_t begin = 0;
+		while (begin < dueTicks.size()) {
+			std::size_t end = begin;
+			if (dueTicks[begin].isRequired()) {
+				while (end < dueTicks.size() && dueTicks[end].isRequired())
+					end++;
+			} else if (isBudgetUsedUp(start)) {
+				break;
+			} else {
+				end = std::min(begin + PARALLEL_BATCH_SIZE, dueTicks.size());
+			}
+
+			pool.parallelFor(end - begin, [&](const std::size_t index, const std::size_t threadIndex) {
+				const DueTick &due = dueTicks[begin + index];
+				tick(due.entity, due.elapsed, threadIndex);
+			});
+
+			for (std::size_t i = begin; i < end; i++) {
+				completeTick(dueTicks[i].entity);
+			}
+			begin = end;
+		}
+
+		removeDeadEntities(ecs);
+	}
+
+	// Time between two ticks in seconds, 0 means every frame. distanceToSquad is in tiles.
+	static double getTickInterval(const AIState state, const float distanceToSquad)
+	{
+		double stateInterval = 0;
+		switch (state) {
+		case AIState::Unaware:
+			stateInterval = 1.0 / 5;
+			break;
+		case AIState::Detecting:
+		case AIState::Searching:
+			stateInterval = 1.0 / 20;
+			break;
+		case AIState::Engaging:
+		case AIState::Fleeing:
+			return 0;
+		}
+
+		double distanceInterval = 0;
+		if (distanceToSquad > 40)
+			distanceInterval = 1.0 / 2;
+		else if (distanceToSquad > 20)
+			distanceInterval = 1.0 / 10;
+
+		return std::max(stateInterval, distanceInterval);
+	}
+
+  private:
+	struct Slot {
+		double elapsed = 0;   // time since the last tick
+		double countdown = 0; // time until the next tick
+		double interval = 0;  // interval used for the last tick
+	};
+
+	struct DueTick {
+		Easys::Entity entity;
+		double overdue; // in intervals
+		double elapsed; // time since the last tick
+
+		// Ticks of entities with an interval of 0 run regardless of the budget.
+		bool isRequired() const { return overdue == std::numeric_limits<double>::max(); }
+	};
+
+	void gatherDueTicks(Easys::ECS &ecs, const double deltaTime)
+	{
+		gatherSquadPositions(ecs);
+		dueTicks.clear();
+
+		for (const Easys::Entity &entity : ecs.getEntities()) {
+			if (!ecs.hasComponent<AI>(entity) || !ecs.hasComponent<Positionable>(entity)) {
+				continue;
+			}
+
+			const float distance = getDistanceToSquad(ecs.getComponent<Positionable>(entity).position) / TILE_SIZE;
+			const double interval = getTickInterval(ecs.getComponent<AI>(entity).state, distance);
+			Slot &slot = getSlot(entity, interval);
+			slot.elapsed += deltaTime;
+			slot.countdown -= deltaTime;
+
+			if (interval == 0) {
+				dueTicks.push_back({entity, std::numeric_limits<double>::max(), slot.elapsed});
+			} else if (slot.countdown <= 0) {
+				dueTicks.push_back({entity, -slot.countdown / interval, slot.elapsed});
+			}
+		}
+
+		std::sort(dueTicks.begin(), dueTicks.end(),
+		          [](const DueTick &a, const DueTick &b) { return a.overdue > b.overdue; });
+	}
+
+	void completeTick(const Easys::Entity entity)
+	{
+		Slot &slot = slots[entity];
+		slot.elapsed = 0;
+		slot.countdown = std::max(0.0, slot.countdown + slot.interval);
+	}
+
+	bool isBudgetUsedUp(const std::chrono::steady_clock::time_point start) const
+	{
+		if (frameBudget == UNLIMITED_BUDGET) {
+			return false;
+		}
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > frameBudget;
+	}
+
+	Slot &getSlot(const Easys::Entity entity, const double interval)
+	{
+		auto [it, inserted] = slots.try_emplace(entity);
+		Slot &slot = it->second;
+		if (inserted) {
+			constexpr double goldenRatio = 0.6180339887498949;
+			phase = std::fmod(phase + goldenRatio, 1.0);
+			slot.countdown = phase * interval;
+		}
+		slot.interval = interval;
+		return slot;
+	}
+
+	float getDistanceToSquad(const Vec2f &position) const
+	{
+		float minDistanceSquared = std::numeric_limits<float>::max();
+		for (const Vec2f &squadPosition : squadPositions) {
+			minDistanceSquared = std::min(minDistanceSquared, (squadPosition - position).lengthSquared());
+		}
+		return std::sqrt(minDistanceSquared);
+	}
+
+	void gatherSquadPositions(Easys::ECS &ecs)
+	{
+		squadPositions.clear();
+		for (const Easys::Entity &entity : ecs.getEntities()) {
+			if (ecs.hasComponent<Controllable>(entity) && ecs.hasComponent<Positionable>(entity)) {
+				squadPositions.push_back(ecs.getComponent<Positionable>(entity).position);
+			}
+		}
+	}
+
+	void removeDeadEntities(Easys::ECS &ecs)
+	{
+		for (auto it = slots.begin(); it != slots.end();) {
+			if (ecs.hasEntity(it->first) && ecs.hasComponent<AI>(it->first))
+				++it;
+			else
+				it = slots.erase(it);
+		}
+	}
+
+	const double frameBudget; // in seconds
+	std::unordered_map<Easys::Entity, Slot> slots;
+	std::vector<DueTick> dueTicks;     // reused every frame to avoid reallocations
+	std::vector<Vec2f> squadPositions; // reused every frame to avoid reallocations
+	double phase = 0;
+};
@@ -0,0 +1,352 @@
+#pragma once
+
+#include "../constants.hpp"
+#include "AIState.hpp"
+#include <cereal/macros.hpp> // CEREAL_NOEXCEPT, needed by rapidxml
+#include <cereal/external/rapidxml/rapidxml.hpp>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Type of a blackboard entry. Every type has its own pool of slots in BTExecutor. Handle is only used for hidden
+// entries, no port has that type.
+enum class PortType : std::uint8_t { Entity, Vec2f, Rotation, Number, State, Handle };
+
+enum class OpCode : std::uint8_t {
+	// control nodes
+	Sequence,
+	ReactiveSequence,
+	Fallback,
+	ReactiveFallback,
+	// leaf nodes, see src/ai/nodes
+	IsEnemyVisible,
+	IsInState,
+	MoveTo,
+	PatrolTo,
+	ShootAt,
+	TurnTo,
+	WaitFor,
+};
+
+// A port resolved at compile time. variable identifies the blackboard entry, index is its slot in the pool of its
+// type. Unconnected ports have variable == Operand::NONE.
+struct Operand {
+	static constexpr std::uint16_t NONE = UINT16_MAX;
+
+	std::uint16_t variable = NONE;
+	std::uint16_t index = 0;
+};
+
+// Instructions are stored in depth first order, so the children of a control node start right after it and the next
+// sibling of a node starts at its end.
+struct Instruction {
+	static constexpr std::size_t MAX_PORTS = 4;
+
+	OpCode op;
+	std::uint16_t end; // index of the first instruction after this subtree
+	std::array<Operand, MAX_PORTS> ports;
+	Operand local; // hidden entry for the state of stateful nodes (e.g. the time WaitFor already waited)
+};
+
+// A behavior tree compiled into a flat instruction array. Shared by every entity running the tree.
+struct CompiledTree {
+	std::string name;
+	std::vector<Instruction> instructions;
+	std::vector<PortType> variableTypes;
+	std::array<std::uint16_t, 6> poolSizes{}; // slots per PortType
+
+	// Initial values of literals (e.g. duration="1").
+	struct Constant {
+		Operand operand;
+		PortType type;
+		double value; // entities, rotations and states are stored as numbers as well
+	};
+	std::vector<Constant> constants;
+
+	Operand entity;    // "entity" of the main tree
+	Operand deltaTime; // "deltaTime" of the main tree
+};
+
+// Compiles the XML trees in BT_DIRECTORY into CompiledTrees.
+//
+// Supports the control nodes Sequence, Fallback and their reactive versions, the leaf nodes in src/ai/nodes and
+// SubTree. Subtrees are inlined with their own scope of blackboard entries. Attributes of a SubTree remap entries of
+// the parent scope or assign literals, like they do for BehaviorTree.CPP. Anything else fails with a std::runtime_error,
+// so callers can fall back to BehaviorTree.CPP.
+class BTCompiler {
+  public:
+	void registerTreesFromDirectory(const std::string &directory)
+	{
+		using std::filesystem::directory_iterator;
+		for (auto const &entry : directory_iterator(directory)) {
+			if (entry.path().extension() == ".xml") {
+				registerTreesFromFile(entry.path().string());
+			}
+		}
+	}
+
+	void registerTreesFromFile(const std::string &path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		auto &document = documents.emplace_back(std::make_unique<Document>());
+		document->buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		registerTreesFromBuffer(*document);
+	}
+
+	void registerTreesFromText(const std::string &text)
+	{
+		auto &document = documents.emplace_back(std::make_unique<Document>());
+		document->buffer.assign(text.begin(), text.end());
+		registerTreesFromBuffer(*document);
+	}
+
+	CompiledTree compile(const std::string &treeName)
+	{
+		CompiledTree tree;
+		tree.name = treeName;
+
+		Scope root;
+		tree.entity = declare(tree, root, "entity", PortType::Entity);
+		tree.deltaTime = declare(tree, root, "deltaTime", PortType::Number);
+
+		compileTree(tree, root, treeName, 0);
+		return tree;
+	}
+
+  private:
+	struct Document {
+		std::vector<char> buffer;
+		cereal::rapidxml::xml_document<> xml;
+	};
+
+	// Blackboard entries visible to a (sub)tree.
+	struct Scope {
+		Scope *parent = nullptr;
+		bool autoRemap = false;
+		std::unordered_map<std::string, std::string> remapped; // key -> value in the parent ("{key}" or a literal)
+		std::unordered_map<std::string, Operand> variables;
+	};
+
+	struct PortDefinition {
+		const char *name;
+		PortType type;
+	};
+
+	struct NodeDefinition {
+		OpCode op;
+		std::vector<PortDefinition> ports; // in the order of Instruction::ports
+	};
+
+	void registerTreesFromBuffer(Document &document)
+	{
+		document.buffer.push_back('\0');
+		document.xml.parse<0>(document.buffer.data());
+
+		const auto *root = document.xml.first_node("root");
+		if (!root) {
+			throw std::runtime_error("Behavior tree file has no <root> element.");
+		}
+
+		for (auto *node = root->first_node("BehaviorTree"); node; node = node->next_sibling("BehaviorTree")) {
+			const auto *id = node->first_attribute("ID");
+			if (id) {
+				trees[id->value()] = node;
+			}
+		}
+	}
+
+	static const std::unordered_map<std::string, NodeDefinition> &getNodeDefinitions()
+	{
+		// clang-format off
+		static const std::unordered_map<std::string, NodeDefinition> definitions = {
+			{"Sequence", {OpCode::Sequence, {}}},
+			{"ReactiveSequence", {OpCode::ReactiveSequence, {}}},
+			{"Fallback", {OpCode::Fallback, {}}},
+			{"ReactiveFallback", {OpCode::ReactiveFallback, {}}},
+			{"IsEnemyVisible", {OpCode::IsEnemyVisible, {{"entity", PortType::Entity},
+			                                             {"otherEntity", PortType::Entity},
+			                                             {"otherPosition", PortType::Vec2f},
+			                                             {"direction", PortType::Rotation}}}},
+			{"IsInState", {OpCode::IsInState, {{"entity", PortType::Entity}, {"state", PortType::State}}}},
+			{"MoveTo", {OpCode::MoveTo, {{"entity", PortType::Entity}, {"position", PortType::Vec2f}}}},
+			{"PatrolTo", {OpCode::PatrolTo, {{"entity", PortType::Entity}, {"targetPosition", PortType::Vec2f},
+			                                 {"direction", PortType::Rotation}, {"duration", PortType::Number}}}},
+			{"ShootAt", {OpCode::ShootAt, {{"entity", PortType::Entity}, {"otherEntity", PortType::Entity},
+			                               {"position", PortType::Vec2f}}}},
+			{"TurnTo", {OpCode::TurnTo, {{"entity", PortType::Entity}, {"direction", PortType::Rotation}}}},
+			{"WaitFor", {OpCode::WaitFor, {{"entity", PortType::Entity}, {"deltaTime", PortType::Number},
+			                               {"duration", PortType::Number}}}},
+		};
+		// clang-format on
+		return definitions;
+	}
+
+	void compileTree(CompiledTree &tree, Scope &scope, const std::string &treeName, int depth)
+	{
+		auto it = trees.find(treeName);
+		if (it == trees.end()) {
+			throw std::runtime_error("Unknown behavior tree \"" + treeName + "\".");
+		}
+		if (depth > 16) {
+			throw std::runtime_error("Behavior tree \"" + treeName + "\" is recursive.");
+		}
+
+		const auto *root = it->second->first_node();
+		while (root && root->type() != cereal::rapidxml::node_element) {
+			root = root->next_sibling();
+		}
+		if (!root || (root->next_sibling() && root->next_sibling()->type() == cereal::rapidxml::node_element)) {
+			throw std::runtime_error("Behavior tree \"" + treeName + "\" needs exactly one root node.");
+		}
+		compileNode(tree, scope, root, depth);
+	}
+
+	void compileNode(CompiledTree &tree, Scope &scope, const cereal::rapidxml::xml_node<> *node, int depth)
+	{
+		const std::string type = node->name();
+
+		if (type == "SubTree") {
+			compileSubTree(tree, scope, node, depth);
+			return;
+		}
+
+		const auto &definitions = getNodeDefinitions();
+		auto it = definitions.find(type);
+		if (it == definitions.end()) {
+			throw std::runtime_error("Node type \"" + type + "\" can not be compiled.");
+		}
+		const NodeDefinition &definition = it->second;
+
+		const std::size_t index = tree.instructions.size();
+		tree.instructions.push_back({definition.op, 0, {}, {}});
+		if (definition.op == OpCode::WaitFor) {
+			tree.instructions[index].local = allocate(tree, PortType::Number);
+		} else if (definition.op == OpCode::MoveTo) {
+			tree.instructions[index].local = allocate(tree, PortType::Vec2f);
+		} else if (definition.op == OpCode::ShootAt) {
+			tree.instructions[index].local = allocate(tree, PortType::Handle);
+		}
+
+		for (std::size_t i = 0; i < definition.ports.size(); i++) {
+			const PortDefinition &port = definition.ports[i];
+			const auto *attribute = node->first_attribute(port.name);
+			if (attribute) {
+				tree.instructions[index].ports[i] = resolve(tree, scope, attribute->value(), port.type);
+			}
+		}
+
+		for (auto *child = node->first_node(); child; child = child->next_sibling()) {
+			if (child->type() == cereal::rapidxml::node_element) {
+				compileNode(tree, scope, child, depth);
+			}
+		}
+
+		if (tree.instructions.size() > UINT16_MAX) {
+			throw std::runtime_error("Behavior tree \"" + tree.name + "\" is too large.");
+		}
+		tree.instructions[index].end = static_cast<std::uint16_t>(tree.instructions.size());
+	}
+
+	void compileSubTree(CompiledTree &tree, Scope &scope, const cereal::rapidxml::xml_node<> *node, int depth)
+	{
+		const auto *id = node->first_attribute("ID");
+		if (!id) {
+			throw std::runtime_error("SubTree without ID.");
+		}
+
+		Scope subScope;
+		subScope.parent = &scope;
+		for (auto *attribute = node->first_attribute(); attribute; attribute = attribute->next_attribute()) {
+			const std::string name = attribute->name();
+			if (name == "_autoremap") {
+				subScope.autoRemap = std::string(attribute->value()) == "true";
+			} else if (name != "ID" && name != "name") {
+				subScope.remapped[name] = attribute->value();
+			}
+		}
+
+		compileTree(tree, subScope, id->value(), depth + 1);
+	}
+
+	// Resolves an attribute value ("{key}" or a literal) to a variable.
+	Operand resolve(CompiledTree &tree, Scope &scope, const std::string &value, PortType type)
+	{
+		if (value.size() > 2 && value.front() == '{' && value.back() == '}') {
+			return resolveKey(tree, scope, value.substr(1, value.size() - 2), type);
+		}
+
+		const Operand operand = allocate(tree, type);
+		tree.constants.push_back({operand, type, parseLiteral(value, type)});
+		return operand;
+	}
+
+	Operand resolveKey(CompiledTree &tree, Scope &scope, const std::string &key, PortType type)
+	{
+		auto variable = scope.variables.find(key);
+		if (variable != scope.variables.end()) {
+			if (tree.variableTypes[variable->second.variable] != type) {
+				throw std::runtime_error("Blackboard entry \"" + key + "\" is used with different types.");
+			}
+			return variable->second;
+		}
+
+		Operand operand;
+		auto remapped = scope.remapped.find(key);
+		if (remapped != scope.remapped.end()) {
+			operand = resolve(tree, *scope.parent, remapped->second, type);
+		} else if (scope.autoRemap && scope.parent) {
+			operand = resolveKey(tree, *scope.parent, key, type);
+		} else {
+			operand = allocate(tree, type);
+		}
+
+		scope.variables[key] = operand;
+		return operand;
+	}
+
+	Operand declare(CompiledTree &tree, Scope &scope, const std::string &key, PortType type)
+	{
+		return scope.variables[key] = allocate(tree, type);
+	}
+
+	Operand allocate(CompiledTree &tree, PortType type)
+	{
+		Operand operand;
+		operand.variable = static_cast<std::uint16_t>(tree.variableTypes.size());
+		operand.index = tree.poolSizes[static_cast<std::size_t>(type)]++;
+		tree.variableTypes.push_back(type);
+		return operand;
+	}
+
+	static double parseLiteral(const std::string &value, PortType type)
+	{
+		if (type == PortType::Rotation) {
+			static const std::unordered_map<std::string, Rotation> rotations = {
+			    {"NORTH", NORTH}, {"EAST", EAST}, {"SOUTH", SOUTH}, {"WEST", WEST}};
+			auto it = rotations.find(value);
+			if (it != rotations.end()) {
+				return it->second;
+			}
+		}
+
+		if (type == PortType::Vec2f) {
+			throw std::runtime_error("Literal \"" + value + "\" can not be used as a position.");
+		}
+
+		try {
+			return std::stod(value);
+		} catch (const std::exception &) {
+			throw std::runtime_error("Literal \"" + value + "\" is not a number.");
+		}
+	}
+
+	std::vector<std::unique_ptr<Document>> documents; // the xml nodes point into these buffers
+	std::unordered_map<std::string, const cereal::rapidxml::xml_node<> *> trees;
+};
@@ -0,0 +1,477 @@
+#pragma once
+
+#include "../components/AI.hpp"
+#include "../components/EquippedWeapon.hpp"
+#include "../components/Pathfinding.hpp"
+#include "../components/Patrol.hpp"
+#include "../components/Positionable.hpp"
+#include "../components/RigidBody.hpp"
+#include "../components/Rotatable.hpp"
+#include "../components/Target.hpp"
+#include "../components/Vision.hpp"
+#include "../engine/types/Vec2f.hpp"
+#include "../modules/EntityHandle.hpp"
+#include "../modules/Utils.hpp"
+#include "AICommands.hpp"
+#include "BTCompiler.hpp"
+#include "nodes/IsEnemyVisible.hpp"
+#include "nodes/ShootAt.hpp"
+#include "behaviortree_cpp/basic_types.h" // NodeStatus
+#include <cstddef>
+#include <cstdint>
+#include <easys/easys.hpp>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Runs a CompiledTree for every entity which uses it.
+//
+// The blackboard entries of all entities live in one pool per type: entity i uses the slots
+// [i * poolSize, (i + 1) * poolSize). Ports were resolved to slots by the compiler, so reading an input is an array
+// access instead of a string lookup, and ticking a node is a switch instead of a virtual call. The leaf nodes behave
+// like their BehaviorTree.CPP counterparts in src/ai/nodes, except that they record their ECS writes in AICommands.
+//
+// Different entities may be ticked concurrently, since each of them only touches its own slots. Adding and removing
+// instances must not happen while ticking.
+class BTExecutor {
+  public:
+	BTExecutor(Easys::ECS &ecs, const EntityGenerations &generations, CompiledTree tree)
+	    : ecs_(ecs), generations_(generations), tree_(std::move(tree))
+	{
+	}
+
+	void addInstance(const Easys::Entity entity)
+	{
+		if (instanceIndices.count(entity)) {
+			removeInstance(entity);
+		}
+
+		const std::size_t instance = instanceEntities.size();
+		instanceIndices[entity] = instance;
+		instanceEntities.push_back(entity);
+
+		entities.resize(entities.size() + poolSize(PortType::Entity));
+		vectors.resize(vectors.size() + poolSize(PortType::Vec2f));
+		rotations.resize(rotations.size() + poolSize(PortType::Rotation), NORTH);
+		numbers.resize(numbers.size() + poolSize(PortType::Number));
+		states.resize(states.size() + poolSize(PortType::State), AIState::Unaware);
+		handles.resize(handles.size() + poolSize(PortType::Handle));
+		assigned.resize(assigned.size() + tree_.variableTypes.size(), 0);
+		running.resize(running.size() + tree_.instructions.size(), 0);
+		childIndices.resize(childIndices.size() + tree_.instructions.size(), 0);
+
+		for (const CompiledTree::Constant &constant : tree_.constants) {
+			writeConstant(instance, constant);
+		}
+		write<Easys::Entity>(instance, tree_.entity, entity);
+		write<double>(instance, tree_.deltaTime, 0.0);
+	}
+
+	// The last instance is moved into the slots of the removed one.
+	void removeInstance(const Easys::Entity entity)
+	{
+		auto it = instanceIndices.find(entity);
+		if (it == instanceIndices.end()) {
+			return;
+		}
+
+		const std::size_t instance = it->second;
+		const std::size_t last = instanceEntities.size() - 1;
+		moveInstance(last, instance);
+		instanceEntities[instance] = instanceEntities[last];
+		instanceIndices[instanceEntities[instance]] = instance;
+		instanceIndices.erase(entity);
+
+		instanceEntities.pop_back();
+		entities.resize(entities.size() - poolSize(PortType::Entity));
+		vectors.resize(vectors.size() - poolSize(PortType::Vec2f));
+		rotations.resize(rotations.size() - poolSize(PortType::Rotation));
+		numbers.resize(numbers.size() - poolSize(PortType::Number));
+		states.resize(states.size() - poolSize(PortType::State));
+		handles.resize(handles.size() - poolSize(PortType::Handle));
+		assigned.resize(assigned.size() - tree_.variableTypes.size());
+		running.resize(running.size() - tree_.instructions.size());
+		childIndices.resize(childIndices.size() - tree_.instructions.size());
+	}
+
+	bool hasInstance(const Easys::Entity entity) const { return instanceIndices.count(entity) > 0; }
+
+	// deltaTime is the time since this entity's tree was last ticked. The ECS is only read, writes are recorded in
+	// commands.
+	BT::NodeStatus tick(const Easys::Entity entity, const double deltaTime, AICommands &commands)
+	{
+		auto it = instanceIndices.find(entity);
+		if (it == instanceIndices.end()) {
+			return BT::NodeStatus::IDLE;
+		}
+
+		return tickInstance(it->second, deltaTime, commands);
+	}
+
+	// Same as above, but writes to the ECS right away.
+	BT::NodeStatus tick(const Easys::Entity entity, const double deltaTime)
+	{
+		AICommands commands;
+		const BT::NodeStatus status = tick(entity, deltaTime, commands);
+		commands.apply(ecs_);
+		return status;
+	}
+
+	const CompiledTree &getTree() const { return tree_; }
+
+  private:
+	BT::NodeStatus tickInstance(const std::size_t instance, const double deltaTime, AICommands &commands)
+	{
+		write<double>(instance, tree_.deltaTime, deltaTime);
+		if (tree_.instructions.empty()) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		return tickNode(instance, 0, commands);
+	}
+
+	BT::NodeStatus tickNode(const std::size_t instance, const std::size_t node, AICommands &commands)
+	{
+		const Instruction &instruction = tree_.instructions[node];
+
+		switch (instruction.op) {
+		case OpCode::Sequence:
+			return tickSequence(instance, node, BT::NodeStatus::SUCCESS, false, commands);
+		case OpCode::ReactiveSequence:
+			return tickSequence(instance, node, BT::NodeStatus::SUCCESS, true, commands);
+		case OpCode::Fallback:
+			return tickSequence(instance, node, BT::NodeStatus::FAILURE, false, commands);
+		case OpCode::ReactiveFallback:
+			return tickSequence(instance, node, BT::NodeStatus::FAILURE, true, commands);
+		case OpCode::IsEnemyVisible:
+			return tickIsEnemyVisible(instance, instruction);
+		case OpCode::IsInState:
+			return tickIsInState(instance, instruction);
+		case OpCode::PatrolTo:
+			return tickPatrolTo(instance, instruction, commands);
+		case OpCode::TurnTo:
+			return tickTurnTo(instance, instruction, commands);
+		case OpCode::MoveTo:
+		case OpCode::ShootAt:
+		case OpCode::WaitFor:
+			return tickStateful(instance, node, commands);
+		}
+
+		return BT::NodeStatus::FAILURE;
+	}
+
+	// Sequences continue while their children succeed, fallbacks while their children fail (= proceed). Reactive
+	// versions start from their first child every tick and halt running children after the one returning RUNNING.
+	BT::NodeStatus tickSequence(const std::size_t instance, const std::size_t node, const BT::NodeStatus proceed,
+	                            const bool isReactive, AICommands &commands)
+	{
+		const std::size_t end = tree_.instructions[node].end;
+		std::uint16_t &current = childIndices[instance * tree_.instructions.size() + node];
+		std::size_t child = (isReactive || current == 0) ? node + 1 : current;
+
+		while (child < end) {
+			const BT::NodeStatus status = tickNode(instance, child, commands);
+
+			if (status == BT::NodeStatus::RUNNING) {
+				if (isReactive)
+					halt(instance, tree_.instructions[child].end, end);
+				else
+					current = static_cast<std::uint16_t>(child);
+				return BT::NodeStatus::RUNNING;
+			}
+
+			if (status != proceed) {
+				halt(instance, node + 1, end);
+				current = 0;
+				return status;
+			}
+
+			child = tree_.instructions[child].end;
+		}
+
+		halt(instance, node + 1, end);
+		current = 0;
+		return proceed;
+	}
+
+	// Resets every node in [begin, end), which is a contiguous range of subtrees.
+	void halt(const std::size_t instance, const std::size_t begin, const std::size_t end)
+	{
+		const std::size_t offset = instance * tree_.instructions.size();
+		std::fill(running.begin() + offset + begin, running.begin() + offset + end, std::uint8_t{0});
+		std::fill(childIndices.begin() + offset + begin, childIndices.begin() + offset + end, std::uint16_t{0});
+	}
+
+	// Like BT::StatefulActionNode: the first tick starts the node, the following ones continue it until it is done.
+	BT::NodeStatus tickStateful(const std::size_t instance, const std::size_t node, AICommands &commands)
+	{
+		const Instruction &instruction = tree_.instructions[node];
+		std::uint8_t &isRunning = running[instance * tree_.instructions.size() + node];
+
+		BT::NodeStatus status = BT::NodeStatus::FAILURE;
+		switch (instruction.op) {
+		case OpCode::MoveTo:
+			status = isRunning ? runMoveTo(instance, instruction) : startMoveTo(instance, instruction, commands);
+			break;
+		case OpCode::ShootAt:
+			status = isRunning ? runShootAt(instance, instruction, commands) : startShootAt(instance, instruction);
+			break;
+		case OpCode::WaitFor:
+			status = isRunning ? runWaitFor(instance, instruction) : startWaitFor(instance, instruction);
+			break;
+		default:
+			break;
+		}
+
+		isRunning = status == BT::NodeStatus::RUNNING;
+		return status;
+	}
+
+	BT::NodeStatus tickIsEnemyVisible(const std::size_t instance, const Instruction &instruction)
+	{
+		const Easys::Entity *entity = read<Easys::Entity>(instance, instruction.ports[0]);
+		if (!entity) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		const Vision &vision = ecs_.getComponent<Vision>(*entity);
+		if (vision.visibleEnemies.empty()) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		const Vec2f &position = ecs_.getComponent<Positionable>(*entity).position;
+		const Rotation &rotation = ecs_.getComponent<Rotatable>(*entity).rotation;
+		const Easys::Entity &otherEntity = vision.visibleEnemies[0];
+		const Vec2f otherPosition = Utils::toFloat(ecs_.getComponent<RigidBody>(otherEntity).startPosition);
+
+		write<Easys::Entity>(instance, instruction.ports[1], otherEntity);
+		write<Vec2f>(instance, instruction.ports[2], otherPosition);
+		write<Rotation>(instance, instruction.ports[3],
+		                IsEnemyVisible::calculateDirection(position, otherPosition, rotation));
+		return BT::NodeStatus::SUCCESS;
+	}
+
+	BT::NodeStatus tickIsInState(const std::size_t instance, const Instruction &instruction)
+	{
+		const Easys::Entity *entity = read<Easys::Entity>(instance, instruction.ports[0]);
+		const AIState *state = read<AIState>(instance, instruction.ports[1]);
+		if (!entity || !state) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		return ecs_.getComponent<AI>(*entity).state == *state ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
+	}
+
+	BT::NodeStatus tickPatrolTo(const std::size_t instance, const Instruction &instruction, AICommands &commands)
+	{
+		const Easys::Entity *entity = read<Easys::Entity>(instance, instruction.ports[0]);
+		if (!entity || !ecs_.hasComponent<Patrol>(*entity)) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		const Vec2f &position = ecs_.getComponent<Positionable>(*entity).position;
+		const auto &targetPosition = ecs_.getComponent<Pathfinding>(*entity).targetPosition;
+		const Patrol &patrol = ecs_.getComponent<Patrol>(*entity);
+		const PatrolPoint &currentPatrolPoint = patrol.waypoints[patrol.patrolIndex];
+
+		// Reached patrol point, set next one.
+		if ((position == Utils::toFloat(targetPosition) && targetPosition == currentPatrolPoint.position)
+		    || targetPosition == Vec2i{-1, -1}) {
+			const int patrolIndex = (patrol.patrolIndex + 1) % patrol.waypoints.size();
+			const PatrolPoint &newPatrolPoint = patrol.waypoints[patrolIndex];
+			commands.setPatrolIndex(*entity, patrolIndex);
+
+			write<Vec2f>(instance, instruction.ports[1], Utils::toFloat(newPatrolPoint.position));
+			write<Rotation>(instance, instruction.ports[2], newPatrolPoint.rotation);
+			write<double>(instance, instruction.ports[3], newPatrolPoint.duration);
+		}
+
+		return BT::NodeStatus::SUCCESS;
+	}
+
+	BT::NodeStatus tickTurnTo(const std::size_t instance, const Instruction &instruction, AICommands &commands)
+	{
+		const Easys::Entity *entity = read<Easys::Entity>(instance, instruction.ports[0]);
+		const Rotation *direction = read<Rotation>(instance, instruction.ports[1]);
+		if (!entity || !direction) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		commands.setRotation(*entity, *direction);
+		return BT::NodeStatus::SUCCESS;
+	}
+
+	BT::NodeStatus startMoveTo(const std::size_t instance, const Instruction &instruction, AICommands &commands)
+	{
+		const Easys::Entity *entity = read<Easys::Entity>(instance, instruction.ports[0]);
+		const Vec2f *position = read<Vec2f>(instance, instruction.ports[1]);
+		if (!entity || !position) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		write<Vec2f>(instance, instruction.local, *position);
+		commands.setPathTarget(*entity, Utils::toInt(*position));
+		return BT::NodeStatus::RUNNING;
+	}
+
+	BT::NodeStatus runMoveTo(const std::size_t instance, const Instruction &instruction)
+	{
+		const Easys::Entity entity = *read<Easys::Entity>(instance, instruction.ports[0]);
+		const Vec2f &targetPosition = *read<Vec2f>(instance, instruction.local);
+
+		if (ecs_.getComponent<Positionable>(entity).position == targetPosition) {
+			return BT::NodeStatus::SUCCESS;
+		}
+		return BT::NodeStatus::RUNNING;
+	}
+
+	BT::NodeStatus startShootAt(const std::size_t instance, const Instruction &instruction)
+	{
+		const Easys::Entity *entity = read<Easys::Entity>(instance, instruction.ports[0]);
+		const Easys::Entity *otherEntity = read<Easys::Entity>(instance, instruction.ports[1]);
+		if (!entity || !otherEntity) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		write<EntityHandle>(instance, instruction.local, generations_.getHandle(*otherEntity));
+		return BT::NodeStatus::RUNNING;
+	}
+
+	BT::NodeStatus runShootAt(const std::size_t instance, const Instruction &instruction, AICommands &commands)
+	{
+		const Easys::Entity entity = *read<Easys::Entity>(instance, instruction.ports[0]);
+		const EntityHandle other = *read<EntityHandle>(instance, instruction.local);
+
+		if (!generations_.isValid(other) || !ShootAt::isInWeaponRange(ecs_, entity, other.entity)) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		if (ShootAt::isDead(ecs_, other.entity)) {
+			return BT::NodeStatus::SUCCESS;
+		}
+
+		commands.setTarget(entity, other);
+		return BT::NodeStatus::RUNNING;
+	}
+
+	BT::NodeStatus startWaitFor(const std::size_t instance, const Instruction &instruction)
+	{
+		write<double>(instance, instruction.local, 0.0);
+		return BT::NodeStatus::RUNNING;
+	}
+
+	BT::NodeStatus runWaitFor(const std::size_t instance, const Instruction &instruction)
+	{
+		const double *deltaTime = read<double>(instance, instruction.ports[1]);
+		const double *duration = read<double>(instance, instruction.ports[2]);
+		if (!read<Easys::Entity>(instance, instruction.ports[0]) || !deltaTime || !duration) {
+			return BT::NodeStatus::FAILURE;
+		}
+
+		double &waited = slot<double>(instance, instruction.local);
+		if (waited <= *duration) {
+			waited += *deltaTime;
+			return BT::NodeStatus::RUNNING;
+		}
+		return BT::NodeStatus::SUCCESS;
+	}
+
+	std::size_t poolSize(const PortType type) const { return tree_.poolSizes[static_cast<std::size_t>(type)]; }
+
+	template <typename T>
+	T &slot(const std::size_t instance, const Operand &operand)
+	{
+		if constexpr (std::is_same_v<T, Easys::Entity>)
+			return entities[instance * poolSize(PortType::Entity) + operand.index];
+		else if constexpr (std::is_same_v<T, Vec2f>)
+			return vectors[instance * poolSize(PortType::Vec2f) + operand.index];
+		else if constexpr (std::is_same_v<T, Rotation>)
+			return rotations[instance * poolSize(PortType::Rotation) + operand.index];
+		else if constexpr (std::is_same_v<T, double>)
+			return numbers[instance * poolSize(PortType::Number) + operand.index];
+		else if constexpr (std::is_same_v<T, EntityHandle>)
+			return handles[instance * poolSize(PortType::Handle) + operand.index];
+		else
+			return states[instance * poolSize(PortType::State) + operand.index];
+	}
+
+	// Returns nullptr for unconnected ports and entries which were never written, like getInput would fail.
+	template <typename T>
+	const T *read(const std::size_t instance, const Operand &operand)
+	{
+		if (operand.variable == Operand::NONE || !assigned[instance * tree_.variableTypes.size() + operand.variable]) {
+			return nullptr;
+		}
+		return &slot<T>(instance, operand);
+	}
+
+	template <typename T>
+	void write(const std::size_t instance, const Operand &operand, const T &value)
+	{
+		if (operand.variable == Operand::NONE) {
+			return;
+		}
+		slot<T>(instance, operand) = value;
+		assigned[instance * tree_.variableTypes.size() + operand.variable] = 1;
+	}
+
+	void writeConstant(const std::size_t instance, const CompiledTree::Constant &constant)
+	{
+		switch (constant.type) {
+		case PortType::Entity:
+			write<Easys::Entity>(instance, constant.operand, static_cast<Easys::Entity>(constant.value));
+			break;
+		case PortType::Rotation:
+			write<Rotation>(instance, constant.operand, static_cast<Rotation>(static_cast<int>(constant.value)));
+			break;
+		case PortType::Number:
+			write<double>(instance, constant.operand, constant.value);
+			break;
+		case PortType::State:
+			write<AIState>(instance, constant.operand, static_cast<AIState>(static_cast<int>(constant.value)));
+			break;
+		case PortType::Vec2f:
+		case PortType::Handle:
+			break; // the compiler rejects position literals, handles only exist as hidden entries
+		}
+	}
+
+	void moveInstance(const std::size_t from, const std::size_t to)
+	{
+		moveSlots(entities, poolSize(PortType::Entity), from, to);
+		moveSlots(vectors, poolSize(PortType::Vec2f), from, to);
+		moveSlots(rotations, poolSize(PortType::Rotation), from, to);
+		moveSlots(numbers, poolSize(PortType::Number), from, to);
+		moveSlots(states, poolSize(PortType::State), from, to);
+		moveSlots(handles, poolSize(PortType::Handle), from, to);
+		moveSlots(assigned, tree_.variableTypes.size(), from, to);
+		moveSlots(running, tree_.instructions.size(), from, to);
+		moveSlots(childIndices, tree_.instructions.size(), from, to);
+	}
+
+	template <typename T>
+	static void moveSlots(std::vector<T> &pool, const std::size_t size, const std::size_t from, const std::size_t to)
+	{
+		std::copy(pool.begin() + from * size, pool.begin() + (from + 1) * size, pool.begin() + to * size);
+	}
+
+	Easys::ECS &ecs_;
+	const EntityGenerations &generations_;
+	const CompiledTree tree_;
+
+	std::vector<Easys::Entity> instanceEntities;
+	std::unordered_map<Easys::Entity, std::size_t> instanceIndices;
+
+	// typed blackboard pools
+	std::vector<Easys::Entity> entities;
+	std::vector<Vec2f> vectors;
+	std::vector<Rotation> rotations;
+	std::vector<double> numbers;
+	std::vector<AIState> states;
+	std::vector<EntityHandle> handles;
+	std::vector<std::uint8_t> assigned; // one flag per blackboard entry
+
+	// node state, one entry per instruction
+	std::vector<std::uint8_t> running;
+	std::vector<std::uint16_t> childIndices;
+};
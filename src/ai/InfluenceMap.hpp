@@ -0,0 +1,214 @@
+#pragma once
+
+#include "../components/AI.hpp"
+#include "../components/Controllable.hpp"
+#include "../components/Positionable.hpp"
+#include "../components/Vision.hpp"
+#include "../constants.hpp"
+#include "../engine/types/Vec2i.hpp"
+#include "../modules/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <easys/easys.hpp>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// A float value per tile, made of units stamped onto the grid with a linear falloff around their tile.
+//
+// The falloff is precomputed as a (2 * radius + 1)^2 kernel. Stamping adds it row by row, so the inner loop runs over
+// contiguous memory and can be vectorised. Removing a stamp subtracts the same values again, so moving a unit only
+// touches the tiles around its old and new tile. Sampling a tile is a single array access.
+class InfluenceLayer {
+  public:
+	void reset(int width, int height, int radius)
+	{
+		width_ = width;
+		height_ = height;
+		radius_ = radius;
+		values.assign(width * height, 0.0f);
+
+		const int size = 2 * radius + 1;
+		kernel.resize(size * size);
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				const float distance = std::sqrt(float((x - radius) * (x - radius) + (y - radius) * (y - radius)));
+				kernel[y * size + x] = std::max(0.0f, 1.0f - distance / float(radius + 1));
+			}
+		}
+	}
+
+	void add(const Vec2i &tile, float weight)
+	{
+		forEachRow(tile, [weight](float *values, const float *kernel, int count) {
+			for (int i = 0; i < count; i++) {
+				values[i] += weight * kernel[i];
+			}
+		});
+	}
+
+	void remove(const Vec2i &tile, float weight) { add(tile, -weight); }
+
+	// Raises every tile to at least the stamp, so stamping the same tile every frame does not pile up.
+	void raise(const Vec2i &tile, float weight)
+	{
+		forEachRow(tile, [weight](float *values, const float *kernel, int count) {
+			for (int i = 0; i < count; i++) {
+				values[i] = std::max(values[i], weight * kernel[i]);
+			}
+		});
+	}
+
+	void scale(float factor)
+	{
+		for (float &value : values) {
+			value *= factor;
+		}
+	}
+
+	// Returns 0 outside of the map.
+	float get(const Vec2i &tile) const { return isInBounds(tile) ? values[tile.y * width_ + tile.x] : 0.0f; }
+
+	bool isInBounds(const Vec2i &tile) const
+	{
+		return tile.x >= 0 && tile.x < width_ && tile.y >= 0 && tile.y < height_;
+	}
+
+	int getWidth() const { return width_; }
+	int getHeight() const { return height_; }
+
+  private:
+	// Calls apply(values, kernel, count) for every row of the kernel around tile, clipped to the map.
+	template <typename Apply>
+	void forEachRow(const Vec2i &tile, Apply &&apply)
+	{
+		const int size = 2 * radius_ + 1;
+		const int beginX = std::max(0, tile.x - radius_);
+		const int endX = std::min(width_, tile.x + radius_ + 1);
+		const int beginY = std::max(0, tile.y - radius_);
+		const int endY = std::min(height_, tile.y + radius_ + 1);
+		if (beginX >= endX) {
+			return;
+		}
+
+		for (int y = beginY; y < endY; y++) {
+			const int kernelRow = (y - tile.y + radius_) * size;
+			apply(&values[y * width_ + beginX], &kernel[kernelRow + beginX - tile.x + radius_], endX - beginX);
+		}
+	}
+
+	int width_ = 0, height_ = 0;
+	int radius_ = 0;
+	std::vector<float> values;
+	std::vector<float> kernel;
+};
+
+// What the guards know about the map, for positioning decisions like flanking or retreating:
+//  - threat: presence of the player's squad (Controllable units)
+//  - ally density: presence of the guards (AI units)
+//  - last known enemy presence: where guards saw squad units, fading out over time (see LAST_KNOWN_ENEMY_DECAY)
+//
+// The presence layers are updated incrementally: every unit remembers the tile it was stamped at and is only moved
+// when it changes its tile. Behavior tree nodes can sample the layers in O(1) instead of scanning their neighbourhood.
+class InfluenceMap {
+  public:
+	void reset(int width, int height)
+	{
+		threat.reset(width, height, INFLUENCE_RADIUS);
+		allyDensity.reset(width, height, INFLUENCE_RADIUS);
+		lastKnownEnemies.reset(width, height, INFLUENCE_RADIUS);
+		stamps.clear();
+	}
+
+	void update(Easys::ECS &ecs, const double deltaTime)
+	{
+		frame++;
+		lastKnownEnemies.scale(std::pow(LAST_KNOWN_ENEMY_DECAY, static_cast<float>(deltaTime)));
+
+		for (const Easys::Entity &entity : ecs.getEntities()) {
+			if (!ecs.hasComponent<Positionable>(entity)) {
+				continue;
+			}
+
+			const Vec2i tile = Utils::toTileSize(ecs.getComponent<Positionable>(entity).position);
+			if (ecs.hasComponent<Controllable>(entity)) {
+				updateStamp(entity, threat, tile);
+			} else if (ecs.hasComponent<AI>(entity)) {
+				updateStamp(entity, allyDensity, tile);
+
+				if (ecs.hasComponent<Vision>(entity)) {
+					for (const Easys::Entity &enemy : ecs.getComponent<Vision>(entity).visibleEnemies) {
+						const Vec2f &position = ecs.getComponent<Positionable>(enemy).position;
+						lastKnownEnemies.raise(Utils::toTileSize(position), 1.0f);
+					}
+				}
+			}
+		}
+
+		// remove units which died or lost their component
+		for (auto it = stamps.begin(); it != stamps.end();) {
+			if (it->second.frame != frame) {
+				it->second.layer->remove(it->second.tile, 1.0f);
+				it = stamps.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	float getThreat(const Vec2i &tile) const { return threat.get(tile); }
+	float getAllyDensity(const Vec2i &tile) const { return allyDensity.get(tile); }
+	float getLastKnownEnemyPresence(const Vec2i &tile) const { return lastKnownEnemies.get(tile); }
+
+	// The tile up to maxDistance tiles (per axis) away with the strongest last known enemy presence, which is where an
+	// enemy was seen most recently. Returns nothing if no enemy was seen around from lately.
+	std::optional<Vec2i> findLastKnownEnemy(const Vec2i &from, const int maxDistance) const
+	{
+		std::optional<Vec2i> strongest;
+		float strongestPresence = MIN_PRESENCE;
+		for (int y = from.y - maxDistance; y <= from.y + maxDistance; y++) {
+			for (int x = from.x - maxDistance; x <= from.x + maxDistance; x++) {
+				const float presence = lastKnownEnemies.get({x, y});
+				if (presence > strongestPresence) {
+					strongestPresence = presence;
+					strongest = Vec2i{x, y};
+				}
+			}
+		}
+		return strongest;
+	}
+
+  private:
+	static constexpr float MIN_PRESENCE = 0.01f; // faded out sightings are ignored
+
+	struct Stamp {
+		InfluenceLayer *layer;
+		Vec2i tile;
+		std::uint64_t frame; // last update which saw the unit
+	};
+
+	void updateStamp(const Easys::Entity entity, InfluenceLayer &layer, const Vec2i &tile)
+	{
+		auto [it, isNew] = stamps.try_emplace(entity, Stamp{&layer, tile, frame});
+		Stamp &stamp = it->second;
+		if (isNew) {
+			layer.add(tile, 1.0f);
+			return;
+		}
+
+		stamp.frame = frame;
+		if (stamp.layer != &layer || stamp.tile != tile) {
+			stamp.layer->remove(stamp.tile, 1.0f);
+			layer.add(tile, 1.0f);
+			stamp.layer = &layer;
+			stamp.tile = tile;
+		}
+	}
+
+	InfluenceLayer threat;
+	InfluenceLayer allyDensity;
+	InfluenceLayer lastKnownEnemies;
+	std::unordered_map<Easys::Entity, Stamp> stamps;
+	std::uint64_t frame = 0;
+};
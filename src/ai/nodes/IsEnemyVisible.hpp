@@ -59,20 +59,8 @@ class IsEnemyVisible : public BT::SyncActionNode {
 		return BT::NodeStatus::SUCCESS;
 	}
 
-  private:
-	// TODO: Implement a base class, which implements this function? Syntax is kind of neat.
-	template <typename T>
-	T getInputOrThrow(const std::string &key)
-	{
-		BT::Expected<T> exp = getInput<T>(key);
-
-		if (!exp)
-			throw std::runtime_error("Node input \"" + key + "\" could not be found.");
-
-		return exp.value();
-	}
-
-	Rotation calculateDirection(const Vec2f &start, const Vec2f &end, const Rotation &currentRotation)
+	// Also used by the compiled trees (see BTExecutor).
+	static Rotation calculateDirection(const Vec2f &start, const Vec2f &end, const Rotation &currentRotation)
 	{
 		// Calculate the difference between the points
 		float dx = end.x - start.x;
@@ -94,5 +82,18 @@ class IsEnemyVisible : public BT::SyncActionNode {
 		}
 	}
 
+  private:
+	// TODO: Implement a base class, which implements this function? Syntax is kind of neat.
+	template <typename T>
+	T getInputOrThrow(const std::string &key)
+	{
+		BT::Expected<T> exp = getInput<T>(key);
+
+		if (!exp)
+			throw std::runtime_error("Node input \"" + key + "\" could not be found.");
+
+		return exp.value();
+	}
+
 	Easys::ECS &ecs;
 };
\ No newline at end of file
@@ -1,15 +1,16 @@
 #pragma once
 
 #include "../../components/EquippedWeapon.hpp"
+#include "../../components/Health.hpp"
 #include "../../components/Pathfinding.hpp"
 #include "../../components/Positionable.hpp"
 #include "../../components/RigidBody.hpp"
 #include "../../components/Target.hpp"
-#include "../../components/Tombstone.hpp"
 #include "../../engine/types/Vec2f.hpp"
 #include "../../items/WeaponDatabase.hpp"
 #include "../../items/WeaponMetadata.hpp"
 #include "../../modules/AStar.hpp"
+#include "../../modules/EntityHandle.hpp"
 #include "behaviortree_cpp/action_node.h"
 #include "behaviortree_cpp/basic_types.h" // ports etc
 #include "behaviortree_cpp/tree_node.h"   // NodeConfig
@@ -19,8 +20,9 @@
 
 class ShootAt : public BT::StatefulActionNode {
   public:
-	ShootAt(const std::string &name, const BT::NodeConfig &config, Easys::ECS &ecs_)
-	    : BT::StatefulActionNode(name, config), ecs(ecs_), wdb(WeaponDatabase::getInstance())
+	ShootAt(const std::string &name, const BT::NodeConfig &config, Easys::ECS &ecs_,
+	        const EntityGenerations &generations_)
+	    : BT::StatefulActionNode(name, config), ecs(ecs_), generations(generations_), wdb(WeaponDatabase::getInstance())
 	{
 	}
 
@@ -45,19 +47,19 @@ class ShootAt : public BT::StatefulActionNode {
 		}
 
 		entity = expEntity.value();
-		otherEntity = expOtherEntity.value();
+		other = generations.getHandle(expOtherEntity.value());
 
 		return BT::NodeStatus::RUNNING;
 	}
 
 	BT::NodeStatus onRunning() override
 	{
-		if (!ecs.hasEntity(otherEntity)) {
+		if (!generations.isValid(other)) {
 			return BT::NodeStatus::FAILURE;
 		}
-		
+
 		// this check could be its own node.
-		if (!isInWeaponRange(ecs, entity, otherEntity)) {
+		if (!isInWeaponRange(ecs, entity, other.entity)) {
 			// TODO: remove Target comp? currently we just reject and let the next node try to handle it.
 			//
 			// Currently we read the other position from the IsEnemyVisible node.
@@ -66,11 +68,11 @@ class ShootAt : public BT::StatefulActionNode {
 			return BT::NodeStatus::FAILURE;
 		}
 
-		if (ecs.hasComponent<Tombstone>(otherEntity)) {
+		if (isDead(ecs, other.entity)) {
 			return BT::NodeStatus::SUCCESS;
 		}
 
-		ecs.addComponent<Target>(entity, Target{otherEntity});
+		ecs.addComponent<Target>(entity, Target{other});
 
 		// Is this a good choice to do here? currently done in firingsystem
 		// ecs.addComponent<Pathfinding>(entity, {}); // clear path
@@ -84,15 +86,8 @@ class ShootAt : public BT::StatefulActionNode {
 		std::cout << "MoveTo node interrupted" << std::endl;
 	}
 
-  private:
-	Easys::ECS &ecs;
-	WeaponDatabase &wdb;
-
-	Easys::Entity entity;
-	Easys::Entity otherEntity;
-
 	// we could think about providing a new module EntityUtils and add this function to it.
-	float calculateDistance(Easys::ECS &ecs, const Easys::Entity entity, const Easys::Entity otherEntity) const
+	static float calculateDistance(Easys::ECS &ecs, const Easys::Entity entity, const Easys::Entity otherEntity)
 	{
 		// technically we would need to check if entities even have a position.
 		// especially if we were to make it part of a generic utility module.
@@ -101,12 +96,27 @@ class ShootAt : public BT::StatefulActionNode {
 		return (pos2 - pos1).length();
 	}
 
-	bool isInWeaponRange(Easys::ECS &ecs, const Easys::Entity entity, const Easys::Entity otherEntity) const
+	// Also used by the compiled trees (see BTExecutor).
+	static bool isInWeaponRange(Easys::ECS &ecs, const Easys::Entity entity, const Easys::Entity otherEntity)
 	{
 		const auto id = ecs.getComponent<EquippedWeapon>(entity).weaponId;
-		const WeaponMetadata wdata = wdb.get(id);
+		const WeaponStats &wdata = WeaponDatabase::getInstance().getStats(id);
 		const float distanceBetweenEntities = calculateDistance(ecs, entity, otherEntity);
 
 		return distanceBetweenEntities < (wdata.range * TILE_SIZE);
 	}
+
+	// Dead entities are removed at the end of the frame they died in (see CleanupSystem).
+	static bool isDead(Easys::ECS &ecs, const Easys::Entity otherEntity)
+	{
+		return ecs.hasComponent<Health>(otherEntity) && ecs.getComponent<Health>(otherEntity).health <= 0;
+	}
+
+  private:
+	Easys::ECS &ecs;
+	const EntityGenerations &generations;
+	WeaponDatabase &wdb;
+
+	Easys::Entity entity;
+	EntityHandle other; // kept while running, the other entity might be removed in the meantime
 };
\ No newline at end of file
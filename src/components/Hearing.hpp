@@ -1,11 +1,26 @@
 #pragma once
 
+#include "../engine/types/Vec2i.hpp"
+#include "Noise.hpp"
+#include <easys/easys.hpp>
 #include <vector>
 
-class SoundSource; // TODO
+// A noise heard during the last perception update.
+struct SoundSource {
+	Easys::Entity source;
+	Vec2i position; // in tile space, where the noise was made
+	NoiseType type;
+	int intensity; // loudness minus the distance the sound travelled, always > 0
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(source, position, type, intensity);
+	}
+};
 
 struct Hearing {
-	int hearingRange = 50;
+	int hearingRange = 50; // in tiles
 	std::vector<SoundSource> heardSounds = {};
 
 	template <class Archive>
@@ -13,4 +28,4 @@ struct Hearing {
 	{
 		archive(hearingRange, heardSounds);
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,5 @@
+#pragma once
+
+// Noises are made by pushing a SoundEvent (see Events.hpp). AIPerceptionSystem propagates them to every entity with a
+// Hearing component.
+enum class NoiseType { Footstep, Gunshot };
@@ -8,15 +8,13 @@
 // If the entity is not moving, end position equals transform.position.
 // If the entity is moving, end position equals the immediate next tile.
 struct RigidBody {
-	bool isMoving = false;   // we could use RigidBody as a temporary component and get rid of this bool
-	bool isShooting = false; // rigidBody is missleading so this should not be here but stays here for now as we need to
-	                         // change to statemachine anyway
-	Vec2i startPosition;     // in pixel space. unused as of now, but might be handy in the future
-	Vec2i nextPosition;      // in pixel space
+	bool isMoving = false; // we could use RigidBody as a temporary component and get rid of this bool
+	Vec2i startPosition;   // in pixel space. unused as of now, but might be handy in the future
+	Vec2i nextPosition;    // in pixel space
 
 	/*template <class Archive>
 	void serialize(Archive &archive)
 	{
-	    archive(isMoving, isShooting, startPosition, endPosition, progress, accumulator);
+	    archive(isMoving, startPosition, endPosition, progress, accumulator);
 	}*/
 };
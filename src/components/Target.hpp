@@ -1,8 +1,8 @@
 #pragma once
 
-#include <easys/easys.hpp>
+#include "../modules/EntityHandle.hpp"
 
 // This is a temporary component an entity has, while it actively tries to engage with an entity.
 struct Target {
-	Easys::Entity entity;
-};
\ No newline at end of file
+	EntityHandle handle; // the engaged entity might be removed while the component exists, see EntityGenerations
+};
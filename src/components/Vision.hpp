@@ -1,14 +1,30 @@
 #pragma once
 
 #include "../constants.hpp"
+#include "../engine/types/Vec2f.hpp"
+#include "../modules/FieldOfView.hpp"
+#include <cstdint>
 #include <easys/easys.hpp>
 #include <vector>
 
+// Everything the visible entities of an observer depend on, besides the positions of the others.
+struct VisionKey {
+	Vec2f position;
+	Vec2f forward;
+	float range = -1;
+	float angle = -1;
+	std::uint64_t obstacleVersion = 0;
+
+	bool operator==(const VisionKey &) const = default;
+};
+
 struct Vision {
 	float range = 20 * TILE_SIZE; // in pixels
 	float angle = 180;            // FOV in degrees
 	std::vector<Easys::Entity> visibleEnemies = {};
 	std::vector<Easys::Entity> visibleAllies = {};
+	FieldOfView fieldOfView; // not serialized, recomputed when the entity changes its tile or rotation
+	VisionKey perceivedFor;  // not serialized, what the visible entities were computed for (see AIPerceptionSystem)
 
 	template <class Archive>
 	void serialize(Archive &archive)
@@ -7,6 +7,13 @@ enum Rotation { NORTH, EAST, SOUTH, WEST };
 
 // In Tile domain (multiply with Tile Size to get pixel values):
 #define BASE_ENTITY_HEIGHT 2
+#define SQUAD_VISION_RADIUS 12 // range of the player's units, used for the fog of war
+#define NOISE_FOOTSTEP 4        // loudness of a noise = how far it travels over open ground
+#define NOISE_GUNSHOT 30
+#define SOUND_PROPAGATION_RANGE 30 // should be the loudest noise
+#define INFLUENCE_RADIUS 6          // in tiles, how far a unit counts towards the influence maps
+#define LAST_KNOWN_ENEMY_DECAY 0.8f // share of the last known enemy presence which is left after a second
+#define SEARCH_RADIUS 15            // how far a guard which lost sight of the squad looks for where it was last seen
 #define WINDOW_WIDTH 440
 #define WINDOW_HEIGHT 280
 #define PIXEL_SIZE 3
@@ -42,8 +49,13 @@ enum Rotation { NORTH, EAST, SOUTH, WEST };
 #define SFX_AK_SHOT_FULL_AUTO_LONG "../assets/audio/sfx/ak_shot_full-auto_long.wav"
 #define BACKGROUND_JUNGLE_AMBIENCE "../assets/audio/music/background_jungle_ambience.mp3"
 #define BACKGROUND_MAIN_MENU "../assets/audio/music/mainmenu_background_lttz.mp3"
+// Sound bank manifest, everything listed here is loaded at startup (see SoundBank)
+#define SOUND_BANK_EFFECTS                                                                                             \
+	{SFX_COLLECT_ITEM, SFX_REMOVE_ITEM, SFX_FOOTSTEP, SFX_SNIPER_SHOT_AND_RELOAD, SFX_AK_SHOT_FULL_AUTO_LONG}
+#define SOUND_BANK_MUSIC {BACKGROUND_MAIN_MENU, BACKGROUND_JUNGLE_AMBIENCE}
 // Behavior trees
 #define BT_DIRECTORY "../assets/ai/trees"
+#define BT_COMPILE_TREES 1 // run trees with the BTExecutor where possible, 0 always uses BehaviorTree.CPP
 // Fonts
 #define FONT_ARIAL "../assets/fonts/Arial.ttf"
 
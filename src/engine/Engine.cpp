@@ -302,6 +302,38 @@ void Engine::drawTexture(const Texture &texture, const Recti &src, const Rectf &
 	SDL_RenderCopyF(renderer_.get(), texture.getSDLTexture(), &sdlSrc, &sdlDst);
 }
 
+void Engine::drawTextures(const Texture &texture, const Recti &src, const std::vector<Rectf> &dsts) const
+{
+	if (dsts.empty()) {
+		return;
+	}
+
+	int textureWidth, textureHeight;
+	SDL_QueryTexture(texture.getSDLTexture(), nullptr, nullptr, &textureWidth, &textureHeight);
+	const float u0 = static_cast<float>(src.x) / textureWidth;
+	const float v0 = static_cast<float>(src.y) / textureHeight;
+	const float u1 = static_cast<float>(src.x + src.w) / textureWidth;
+	const float v1 = static_cast<float>(src.y + src.h) / textureHeight;
+	const SDL_Color white = {255, 255, 255, 255};
+
+	// two triangles per quad
+	std::vector<SDL_Vertex> vertices;
+	std::vector<int> indices;
+	vertices.reserve(dsts.size() * 4);
+	indices.reserve(dsts.size() * 6);
+	for (const Rectf &dst : dsts) {
+		const int first = static_cast<int>(vertices.size());
+		vertices.push_back({{dst.x, dst.y}, white, {u0, v0}});
+		vertices.push_back({{dst.x + dst.w, dst.y}, white, {u1, v0}});
+		vertices.push_back({{dst.x + dst.w, dst.y + dst.h}, white, {u1, v1}});
+		vertices.push_back({{dst.x, dst.y + dst.h}, white, {u0, v1}});
+		indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+	}
+
+	SDL_RenderGeometry(renderer_.get(), texture.getSDLTexture(), vertices.data(), static_cast<int>(vertices.size()),
+	                   indices.data(), static_cast<int>(indices.size()));
+}
+
 void Engine::drawTexture(const Texture &texture, const Recti &src, const Recti &dst, const double &angle,
                          const Vec2i &center, const TextureFlip &flip) const
 {
@@ -64,6 +64,8 @@ class Engine {
 	                 const Vec2i &center, const TextureFlip &flip) const;
 	void drawTexture(const Texture &texture, const Recti &src, const Rectf &dst, const double &angle,
 	                 const Vec2f &center, const TextureFlip &flip) const;
+	// Draws the same part of a texture to many places with a single draw call.
+	void drawTextures(const Texture &texture, const Recti &src, const std::vector<Rectf> &dsts) const;
 	SDL_Texture *loadSDLTexture(const std::string &path) const;
 	Texture loadTexture(const std::string &path) const;
 	void drawText(const Recti &dst, const std::string &text) const;
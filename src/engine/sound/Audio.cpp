@@ -1,6 +1,7 @@
 #include "Audio.hpp"
+#include <algorithm>
+#include <bit>
 #include <cmath>
-#include <numbers>
 
 Audio::Audio() : channelManager_()
 {
@@ -11,17 +12,24 @@ Audio::Audio() : channelManager_()
 	    < 0)
 		fprintf(stderr, "Audio initialization failed: %s\n", Mix_GetError());
 	Mix_AllocateChannels(AudioConfig::VIRTUAL_CHANNELS);
+	Mix_ChannelFinished(&ChannelManager::onChannelFinished);
 }
 
 Audio::~Audio()
 {
+	Mix_ChannelFinished(NULL);
+	soundBank_.clear(); // chunks and music have to be freed while the device is still open
 	Mix_CloseAudio();
 	Mix_Quit(); // if we need Mix_Init(), we also need to call this
 }
 
 void Audio::update()
 {
-	channelManager_.resetChannels(); 
+	std::uint32_t released = channelManager_.releaseFinishedChannels();
+	while (released != 0) {
+		spatializer_.release(std::countr_zero(released));
+		released &= released - 1;
+	}
 }
 
 Music Audio::loadMusicFile(const std::string &pathToSoundFile) const // make a type for music and chunks
@@ -67,65 +75,117 @@ SoundEffect Audio::loadSoundEffectFile(const std::string &pathToSoundFile) const
 	return SoundEffect(cStrPath);
 }
 
-int Audio::playSoundEffect(const std::shared_ptr<SoundEffect> soundEffect_Ptr, const EmissionOptions &emissionOptions) const
+int Audio::playSoundEffect(const int channel, const std::shared_ptr<SoundEffect> soundEffect_Ptr,
+                           const EmissionOptions &emissionOptions) const
 {
 	Mix_Chunk *SDL_ChunkType = soundEffect_Ptr->getSoundEffect();
 	if (emissionOptions.fadeMs > 0) {
-		return Mix_FadeInChannel(AudioConfig::ANY_CHANNEL, SDL_ChunkType, emissionOptions.loops,
-		                         emissionOptions.fadeMs);
+		return Mix_FadeInChannel(channel, SDL_ChunkType, emissionOptions.loops, emissionOptions.fadeMs);
 	} else {
-		return Mix_PlayChannel(AudioConfig::ANY_CHANNEL, SDL_ChunkType, emissionOptions.loops);
+		return Mix_PlayChannel(channel, SDL_ChunkType, emissionOptions.loops);
 	}
 }
 
-int Audio::emit2D(
-    const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
-    const EmissionOptions &emissionOptions) // should prolly be const and setting of channel data happen somewhere else
+int Audio::startVoice(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
+                      const EmissionOptions &emissionOptions, const int distance)
 {
-	if (!channelManager_.isEmitterPlayingThis(emitterID, soundEffect_Ptr)) {
-		Mix_Chunk *SDL_ChunkType = soundEffect_Ptr->getSoundEffect();
+	const int channel = channelManager_.allocateChannel(emissionOptions.priority, distance);
+	if (channel == AudioConfig::ANY_CHANNEL) {
+		return AudioConfig::ANY_CHANNEL; // every channel is busy with a more important sound
+	}
 
-		int channelChosen = playSoundEffect(soundEffect_Ptr, emissionOptions);
+	const bool isReplacing = channelManager_.getChannelData(channel).emitterID != -1;
+	if (isReplacing) {
+		Mix_HaltChannel(channel);
+	}
+	const int channelChosen = playSoundEffect(channel, soundEffect_Ptr, emissionOptions);
+	if (isReplacing) {
+		channelManager_.forgetFinished(channel); // the halt reported the replaced voice as finished
+	}
+	spatializer_.release(channel); // emit3D sets the position of 3d voices
 
-		channelManager_.setChannelData(channelChosen, emitterID, soundEffect_Ptr, AudioConfig::DEFAULT_VOLUME,
-		                               -1); 
+	if (channelChosen == AudioConfig::ANY_CHANNEL) {
+		if (isReplacing) {
+			channelManager_.releaseChannel(channel); // the replaced voice is halted, nothing plays here anymore
+		}
+		return AudioConfig::ANY_CHANNEL;
 	}
-	return channelManager_.whereIsEmitterPlayingThis(emitterID, soundEffect_Ptr);
+	channelManager_.setChannelData(channelChosen, emitterID, soundEffect_Ptr, AudioConfig::DEFAULT_VOLUME, -1,
+	                               emissionOptions.priority, distance);
+	return channelChosen;
 }
 
-int Audio::applySpatialization(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
-                                const Vec2f &emitterPosition, const Vec2f &listenerPosition,
-                                const EmissionOptions &emissionOptions) const{
-
-    int angle = calculateAudioAngle(emitterPosition, listenerPosition);
-	int distance = calculateAudioDistance(emitterPosition, listenerPosition, emissionOptions.distance_modifier);
-	int channel = channelManager_.whereIsEmitterPlayingThis(emitterID, soundEffect_Ptr);
-	if (distance <= 255) { // normalize distance --> why though, I have to feed it into setposition here anyhow
-		if (getVolume(channel) == 0) {
-			setVolume(AudioConfig::DEFAULT_VOLUME, channel);
-		}
-		Mix_SetPosition(channel, static_cast<Sint16>(angle), static_cast<Uint8>(distance));
-	} else {
-		setVolume(channel, 0);
+int Audio::emit2D(
+    const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
+    const EmissionOptions &emissionOptions) // should prolly be const and setting of channel data happen somewhere else
+{
+	const int channel = channelManager_.whereIsEmitterPlayingThis(emitterID, soundEffect_Ptr);
+	if (channel != AudioConfig::ANY_CHANNEL) {
+		return channel;
 	}
-	return channel;
+	return startVoice(emitterID, soundEffect_Ptr, emissionOptions, 0);
 }
 
+void Audio::updateSpatialization(const Vec2f &listenerPosition)
+{
+	listener_.update(listenerPosition);
+	const auto apply = [this](const int channel, const int angle, const int distance) {
+		// normalize distance --> why though, I have to feed it into setposition here anyhow
+		if (distance <= AudioConfig::MAX_DISTANCE) {
+			if (getVolume(channel) == 0) {
+				setVolume(AudioConfig::DEFAULT_VOLUME, channel);
+			}
+			Mix_SetPosition(channel, static_cast<Sint16>(angle), static_cast<Uint8>(distance));
+		} else {
+			setVolume(0, channel); // the emitter moved out of range while playing
+		}
+	};
+	spatializer_.update(listener_.getListenerPosition(), apply);
+}
 
 int Audio::emit3D(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
                   const Vec2f &emitterPosition, const Vec2f &listenerPosition, const EmissionOptions &emissionOptions)
 {
-	int channelChosen; // TODO return emit2D directly not with this variable -> I cannot?!
-	if (!channelManager_.isEmitterPlayingThis(emitterID, soundEffect_Ptr)) {
-		channelChosen = emit2D(emitterID, soundEffect_Ptr, emissionOptions);
-	} else {
-		channelChosen = channelManager_.whereIsEmitterPlayingThis(emitterID, soundEffect_Ptr);
+	int channelChosen = channelManager_.whereIsEmitterPlayingThis(emitterID, soundEffect_Ptr);
+	const bool isNewVoice = channelChosen == AudioConfig::ANY_CHANNEL;
+	if (isNewVoice) {
+		const int distance =
+		    calculateAudioDistance(emitterPosition, listenerPosition, emissionOptions.distance_modifier);
+		if (distance > AudioConfig::MAX_DISTANCE) {
+			return AudioConfig::ANY_CHANNEL; // culled, too far away to be heard, so it does not take a channel
+		}
+		channelChosen = startVoice(emitterID, soundEffect_Ptr, emissionOptions, distance);
+		if (channelChosen == AudioConfig::ANY_CHANNEL) {
+			return channelChosen;
+		}
 	}
-	applySpatialization(emitterID, soundEffect_Ptr, emitterPosition, listenerPosition, emissionOptions);
+	spatializer_.setEmitter(channelChosen, emitterPosition, emissionOptions.distance_modifier, isNewVoice);
 
 	return channelChosen;
 }
 
+void Audio::queueEmission3D(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
+                            const Vec2f &emitterPosition, const EmissionOptions &emissionOptions)
+{
+	queuedEmissions_.push_back({emitterID, soundEffect_Ptr, emitterPosition, emissionOptions});
+}
+
+void Audio::playQueuedEmissions(const Vec2f &listenerPosition)
+{
+	std::stable_sort(queuedEmissions_.begin(), queuedEmissions_.end(),
+	                 [](const QueuedEmission &a, const QueuedEmission &b) {
+		                 return a.emissionOptions.priority > b.emissionOptions.priority;
+	                 });
+
+	for (const QueuedEmission &emission : queuedEmissions_) {
+		emit3D(emission.emitterID, emission.soundEffect_Ptr, emission.emitterPosition, listenerPosition,
+		       emission.emissionOptions);
+	}
+	queuedEmissions_.clear();
+
+	updateSpatialization(listenerPosition);
+}
+
 
 
 void Audio::pauseEmission(const int channelToPause) const
@@ -178,15 +238,6 @@ void Audio::setVolume(const int &volume, const int &channel) const
 	Mix_Volume(channel, volume);
 }
 
-int Audio::calculateAudioAngle(const Vec2f &emitterPosition, const Vec2f &listenerPosition) const
-{
-	float adjacent = emitterPosition.x - listenerPosition.x;
-	float opposite = emitterPosition.y - listenerPosition.y;
-	float angleInRadians = std::atan2(opposite, adjacent);
-	float angleInDegrees = angleInRadians * 180 / std::numbers::pi;
-	return static_cast<int>(angleInDegrees);
-}
-
 int Audio::calculateAudioDistance(const Vec2f &emitterPosition, const Vec2f &listenerPosition,
                                   const int distance_modifier) const
 {
@@ -198,4 +249,9 @@ int Audio::calculateAudioDistance(const Vec2f &emitterPosition, const Vec2f &lis
 const ChannelManager &Audio::getChannelManager() const
 {
 	return channelManager_;
+}
+
+SoundBank &Audio::getSoundBank()
+{
+	return soundBank_;
 }
\ No newline at end of file
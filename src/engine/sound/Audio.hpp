@@ -4,10 +4,13 @@
 #include "AudioConstants.hpp"
 #include "ChannelManager.hpp"
 #include "Listener.hpp"
+#include "SoundBank.hpp"
+#include "Spatializer.hpp"
 #include <SDL_mixer.h>
 #include <concepts>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 	
 class Audio {
@@ -22,9 +25,10 @@ class Audio {
 		int loops = 0;
 		int fadeMs = 0;
 		int distance_modifier = 1; // a way to let game developer influence distance calculation
+		int priority = AudioConfig::DEFAULT_PRIORITY; // decides which sounds play when all channels are busy
 	};
 
-	//audios update function meant to run in the engine every frame. currently only used for reseting channels in the channel manager
+	//audios update function meant to run in the engine every frame. frees the channels of finished sounds
 	void update();
 
 	// loads file from specified path in proprietary format. please use .mp3 or .ogg files only
@@ -51,17 +55,25 @@ class Audio {
 	int emit2D(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
 	           const EmissionOptions &emissionOptions = {});
 
-	//apply a simple 3d spatialization effect on a specified playing soundfile
-	int applySpatialization(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
-	                         const Vec2f &emitterPosition, const Vec2f &listenerPosition,
-	                        const EmissionOptions &emissionOptions = {}) const;
+	//applies a simple 3d spatialization effect on all playing 3d voices at once (see Spatializer)
+	//only voices that moved are sent to the mixer
+	void updateSpatialization(const Vec2f &listenerPosition);
 
 	// plays specified SoundEffect file on any free channel using a simple 3d spacialization effect, use the distance modifier
 	// emission option to influence cut off (higher modifier decreases distance for cut off. i.e. 2 = half the distance)
-	// returns the chosen channel id
+	// the position is applied by the next updateSpatialization. returns the chosen channel id
 	int emit3D(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr, const Vec2f &emitterPosition,
 	           const Vec2f &listenerPosition, const EmissionOptions &emissionOptions = {});
 
+	// queues a sound for playQueuedEmissions instead of playing it right away, so the sounds of a frame get their
+	// channels by priority and not in the order they were made
+	void queueEmission3D(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
+	                     const Vec2f &emitterPosition, const EmissionOptions &emissionOptions = {});
+
+	// plays all queued sounds with emit3D, highest priority first, clears the queue and updates the spatialization.
+	// meant to run once per frame
+	void playQueuedEmissions(const Vec2f &listenerPosition);
+
 	// pauses emission (timestamp kept) on specified, or all channels
 	void pauseEmission(const int channelToPause = AudioConfig::ANY_CHANNEL) const;
 
@@ -91,15 +103,32 @@ class Audio {
 
 	const ChannelManager& getChannelManager() const;
 
+	// every sound of the game, preloaded at startup
+	SoundBank &getSoundBank();
+
 
   private:
+	struct QueuedEmission {
+		int emitterID;
+		std::shared_ptr<SoundEffect> soundEffect_Ptr;
+		Vec2f emitterPosition;
+		EmissionOptions emissionOptions;
+	};
+
 	ChannelManager channelManager_;
+	Spatializer spatializer_; // positions of the playing 3d voices
+	Listener listener_;
+	SoundBank soundBank_;
+	std::vector<QueuedEmission> queuedEmissions_; // reused every frame
 
-	int playSoundEffect(const std::shared_ptr<SoundEffect> soundEffect_Ptr,
+	int playSoundEffect(const int channel, const std::shared_ptr<SoundEffect> soundEffect_Ptr,
 	                    const EmissionOptions &emissionOptions = {}) const;
 
-	int calculateAudioAngle(const Vec2f &emitterPosition,
-	                           const Vec2f &listenerPosition) const;
+	// starts a new voice on the channel picked by ChannelManager::allocateChannel
+	// returns ANY_CHANNEL if it was dropped
+	int startVoice(const int &emitterID, const std::shared_ptr<SoundEffect> &soundEffect_Ptr,
+	               const EmissionOptions &emissionOptions, const int distance);
+
 	int calculateAudioDistance(const Vec2f &emitterPosition, const Vec2f &listenerPosition, const int distance_modifier) const;
 
 	
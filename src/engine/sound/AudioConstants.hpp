@@ -18,6 +18,10 @@ namespace AudioConfig {
 													// 32 is a good default. Errors/warnings to be designed so that increasing the number of channels is given
 													// as an option
     constexpr int DEFAULT_VOLUME = 50;				// arbitrary
+	constexpr int DEFAULT_PRIORITY = 0;				// higher priority sounds take over channels from lower ones
+	constexpr int MAX_DISTANCE = 255;				// farthest audible distance (Mix_SetPosition), farther is culled
+	constexpr int ANGLE_THRESHOLD = 2;				// in degrees, smaller movements are not sent to the mixer
+	constexpr int DISTANCE_THRESHOLD = 2;			// same for the distance, in Mix_SetPosition units
 
 	constexpr int ANY_CHANNEL = -1;					// wrapping SDL_mixers -1 for all channels
 
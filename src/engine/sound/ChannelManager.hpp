@@ -9,6 +9,9 @@
 #include <string>
 #include "Audio.hpp"
 #include <array> 
+#include <atomic>
+#include <bit>
+#include <cstdint>
 
 class ChannelManager {
 public:
@@ -17,7 +20,7 @@ public:
 		// started using constexpr and namespaces for this, idea would be 1 engine config file with multiple namespaces
 		// that the game developer has to set 1 time.
 		for (int index = 0; index < AudioConfig::VIRTUAL_CHANNELS; index++) {
-			channelManagementList_[index] = { -1, nullptr, 0, -1 };
+			channelManagementList_[index] = {-1, nullptr, 0, -1, 0, 0};
 		}
 	};
 	~ChannelManager() {};
@@ -28,29 +31,67 @@ public:
 		std::shared_ptr<SoundEffect> activeTrack_Ptr;
 		int volume;
 		int assingedGroup; //TODO --> necessary functions to get groups
+		int priority; // when all channels are busy, the voice with the lowest priority is replaced first
+		int distance; // to the listener when the voice started, the farther voice is replaced on equal priority
 	};
 
-	//TODO --> Exchange with callback function
-	void resetChannels() 
+	// Registered with Mix_ChannelFinished. SDL_mixer calls it on its audio thread (or inside Mix_HaltChannel), where
+	// calling back into SDL_mixer is not allowed, so the channel is only marked here and freed by
+	// releaseFinishedChannels on the main thread.
+	static void onChannelFinished(int channelID) { finishedChannels_.fetch_or(std::uint32_t{1} << channelID); }
+
+	// Frees the channels which finished since the last call and returns them as a bit mask. Nothing is polled, so this
+	// costs one atomic exchange plus one step per finished sound.
+	std::uint32_t releaseFinishedChannels()
 	{
-		for (int index = 0; index < channelManagementList_.size(); index++) {
-			if (!isChannelPlaying(index)) {
-				ChannelData &openedChannelData = channelManagementList_[index];
-				openedChannelData = {-1, nullptr, 0, -1};
-			}
+		const std::uint32_t released = finishedChannels_.exchange(0);
+		std::uint32_t finished = released;
+		while (finished != 0) {
+			const int index = std::countr_zero(finished);
+			finished &= finished - 1;
+			releaseChannel(index);
 		}
+		return released;
 	}
 
+	void releaseChannel(const int channelID) { channelManagementList_[channelID] = {-1, nullptr, 0, -1, 0, 0}; }
+
+	// A halted channel which is played again right away must not be freed by releaseFinishedChannels.
+	void forgetFinished(const int channelID) { finishedChannels_.fetch_and(~(std::uint32_t{1} << channelID)); }
+
 	void setChannelData(const int channelID, const int emitterID, const std::shared_ptr<SoundEffect> activeTrack_Ptr,
-	                    const int volume, const int assingedGroup)
+	                    const int volume, const int assingedGroup, const int priority = AudioConfig::DEFAULT_PRIORITY,
+	                    const int distance = 0)
 	{
 		if (channelID != AudioConfig::ANY_CHANNEL) {
-			ChannelData nowPlaying = {emitterID, activeTrack_Ptr, volume, assingedGroup};
+			ChannelData nowPlaying = {emitterID, activeTrack_Ptr, volume, assingedGroup, priority, distance};
 			channelManagementList_[channelID] = nowPlaying;
 		}
 	}
 
-	ChannelData getChannelData(const int channelID) const { return channelManagementList_[channelID]; }
+	const ChannelData &getChannelData(const int channelID) const { return channelManagementList_[channelID]; }
+
+	// Picks the channel for a new voice: a free one if there is any, otherwise the least important voice if the new one
+	// is more important (higher priority, or closer on equal priority). Returns ANY_CHANNEL if the new voice should be
+	// dropped. A replaced voice is still playing and has to be halted by the caller.
+	int allocateChannel(const int priority, const int distance) const
+	{
+		int victim = AudioConfig::ANY_CHANNEL;
+		for (int index = 0; index < AudioConfig::VIRTUAL_CHANNELS; index++) {
+			const ChannelData &data = channelManagementList_[index];
+			if (data.emitterID == -1) {
+				return index;
+			}
+			if (victim == AudioConfig::ANY_CHANNEL || isLessImportant(data, channelManagementList_[victim])) {
+				victim = index;
+			}
+		}
+
+		const ChannelData &replaced = channelManagementList_[victim];
+		const bool isMoreImportant =
+		    priority > replaced.priority || (priority == replaced.priority && distance < replaced.distance);
+		return isMoreImportant ? victim : AudioConfig::ANY_CHANNEL;
+	}
 
 	bool isChannelPlaying(const int channelID) const
 	{
@@ -94,8 +135,16 @@ public:
 	}
 
   private:
+	static_assert(AudioConfig::VIRTUAL_CHANNELS <= 32, "finished channels are tracked in a 32 bit mask");
+
+	static bool isLessImportant(const ChannelData &a, const ChannelData &b)
+	{
+		return a.priority < b.priority || (a.priority == b.priority && a.distance > b.distance);
+	}
 
 	std::array<ChannelData, AudioConfig::VIRTUAL_CHANNELS> channelManagementList_;
 
+	inline static std::atomic<std::uint32_t> finishedChannels_{0}; // one bit per channel, set by onChannelFinished
+
 };
 
@@ -1,9 +1,8 @@
 #pragma once
 
 #include "../types.hpp"
-#include "Audio.hpp"
 
-//Currently not used as our Listener is always the Camera Position.
+//Our Listener is always the Camera Position, it is set once per frame (see Audio::updateSpatialization).
 class Listener {
   public:
 	Listener() : listenerPosition_(Vec2f{0.00f, 0.00f}) {} //using initialization list
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../types/Music.hpp"
+#include "../types/SoundEffect.hpp"
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Owns every sound of the game, loaded ahead of time, so no file is read or decoded on the game thread while playing.
+//
+// Sound effects are decoded on a worker thread. Mix_LoadWAV converts them to the format of the opened audio device
+// while loading, so a chunk is converted exactly once and playing it is only mixing. It does not touch the playing
+// channels, which is why it can run next to the game thread. Music is streamed by SDL_mixer anyway, so it is only
+// opened, on the calling thread, when preloading.
+//
+// Paths are the keys, so a path listed more than once is loaded once and everyone asking for it shares the sound.
+class SoundBank {
+  public:
+	SoundBank() = default;
+	~SoundBank() { waitForDecoding(); } // the worker writes into the bank
+
+	SoundBank(const SoundBank &) = delete;
+	SoundBank &operator=(const SoundBank &) = delete;
+
+	// Has to be called after the audio device was opened (see Audio::Audio), otherwise there is no format to convert
+	// to.
+	void preload(const std::vector<std::string> &soundEffectPaths, const std::vector<std::string> &musicPaths)
+	{
+		waitForDecoding();
+
+		// the entries are created here, so the worker only fills them and never changes the map itself
+		std::vector<std::pair<std::string, std::shared_ptr<SoundEffect> *>> toDecode;
+		for (const std::string &path : soundEffectPaths) {
+			auto [it, isNew] = soundEffects_.try_emplace(path);
+			if (isNew) {
+				toDecode.push_back({path, &it->second});
+			}
+		}
+
+		for (const std::string &path : musicPaths) {
+			if (!music_.count(path)) {
+				music_.emplace(path, Music(path.c_str()));
+			}
+		}
+
+		decoding_ = std::async(std::launch::async, [toDecode = std::move(toDecode)]() {
+			for (const auto &[path, soundEffect] : toDecode) {
+				*soundEffect = std::make_shared<SoundEffect>(path.c_str());
+			}
+		});
+	}
+
+	// Waits for the worker, if it is still decoding. A path which was not preloaded is loaded right away and reported
+	// once, since it should be added to the manifest.
+	const std::shared_ptr<SoundEffect> &getSoundEffect(const std::string &path)
+	{
+		waitForDecoding();
+
+		std::shared_ptr<SoundEffect> &soundEffect = soundEffects_[path];
+		if (!soundEffect) {
+			reportNotPreloaded("Sound effect", path);
+			soundEffect = std::make_shared<SoundEffect>(path.c_str());
+		}
+		return soundEffect;
+	}
+
+	const Music &getMusic(const std::string &path)
+	{
+		auto it = music_.find(path);
+		if (it == music_.end()) {
+			reportNotPreloaded("Music", path);
+			it = music_.emplace(path, Music(path.c_str())).first;
+		}
+		return it->second;
+	}
+
+	// Frees every sound. Has to happen before the audio device is closed.
+	void clear()
+	{
+		waitForDecoding();
+		soundEffects_.clear();
+		music_.clear();
+	}
+
+  private:
+	void reportNotPreloaded(const char *kind, const std::string &path)
+	{
+		if (reported_.insert(path).second) {
+			std::cerr << "Error: " << kind << " was not preloaded: " << path << std::endl;
+		}
+	}
+
+	void waitForDecoding()
+	{
+		if (decoding_.valid()) {
+			decoding_.get();
+		}
+	}
+
+	std::unordered_map<std::string, std::shared_ptr<SoundEffect>> soundEffects_;
+	std::unordered_map<std::string, Music> music_;
+	std::future<void> decoding_;
+	std::unordered_set<std::string> reported_; // paths which were requested without being preloaded
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../types/Vec2f.hpp"
+#include "AudioConstants.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+// Panning and attenuation of every playing 3d voice, computed in one pass per frame instead of once per emission.
+//
+// The emitter positions are stored as structure of arrays with one entry per channel, and the angles are computed for
+// all channels without branches or conditional floating point operations, so the compiler vectorises the loop with the
+// default flags. Idle channels are computed as well, which is cheaper than skipping them. The distances are a separate
+// loop, since std::sqrt only vectorises without errno (-fno-math-errno).
+//
+// Only voices whose angle or distance moved by at least the thresholds in AudioConfig, or which entered or left the
+// range, are reported, so the mixer is not called for voices which did not (noticeably) move.
+class Spatializer {
+  public:
+	Spatializer()
+	{
+		positionsX.fill(0.f);
+		positionsY.fill(0.f);
+		distanceModifiers.fill(1.f);
+		angles.fill(0);
+		distances.fill(0);
+		appliedAngles.fill(NOT_APPLIED);
+		appliedDistances.fill(NOT_APPLIED);
+		isActive.fill(0);
+	}
+
+	// A new voice is always reported by the next update, since SDL_mixer drops the position of a finished channel.
+	void setEmitter(const int channel, const Vec2f &emitterPosition, const int distanceModifier, const bool isNewVoice)
+	{
+		positionsX[channel] = emitterPosition.x;
+		positionsY[channel] = emitterPosition.y;
+		distanceModifiers[channel] = static_cast<float>(distanceModifier);
+		isActive[channel] = 1;
+		if (isNewVoice) {
+			appliedAngles[channel] = NOT_APPLIED;
+			appliedDistances[channel] = NOT_APPLIED;
+		}
+	}
+
+	void release(const int channel) { isActive[channel] = 0; }
+
+	// Calls apply(channel, angle, distance) for every active voice which moved far enough since it was last applied.
+	// The angle is in degrees like calculated by atan2, the distance in pixels times the distance modifier. Distances
+	// beyond AudioConfig::MAX_DISTANCE are reported as MAX_DISTANCE + 1, so voices out of range settle as well.
+	template <typename Apply>
+	void update(const Vec2f &listenerPosition, Apply &&apply)
+	{
+		computeAnglesAndDistances(listenerPosition);
+
+		for (int channel = 0; channel < AudioConfig::VIRTUAL_CHANNELS; channel++) {
+			if (!isActive[channel] || !hasMoved(channel)) {
+				continue;
+			}
+			appliedAngles[channel] = angles[channel];
+			appliedDistances[channel] = distances[channel];
+			apply(channel, angles[channel], distances[channel]);
+		}
+	}
+
+	int getAngle(const int channel) const { return angles[channel]; }
+	int getDistance(const int channel) const { return distances[channel]; }
+
+  private:
+	static constexpr int NOT_APPLIED = std::numeric_limits<int>::min();
+	static constexpr float RADIANS_TO_DEGREES = 180.f / 3.14159265f;
+
+	void computeAnglesAndDistances(const Vec2f &listenerPosition)
+	{
+		for (int channel = 0; channel < AudioConfig::VIRTUAL_CHANNELS; channel++) {
+			const float adjacent = positionsX[channel] - listenerPosition.x;
+			const float opposite = positionsY[channel] - listenerPosition.y;
+			angles[channel] = static_cast<int>(approximateAtan2(opposite, adjacent) * RADIANS_TO_DEGREES);
+		}
+
+		for (int channel = 0; channel < AudioConfig::VIRTUAL_CHANNELS; channel++) {
+			const float adjacent = positionsX[channel] - listenerPosition.x;
+			const float opposite = positionsY[channel] - listenerPosition.y;
+			const float distance = std::sqrt(adjacent * adjacent + opposite * opposite) * distanceModifiers[channel];
+			distances[channel] = static_cast<int>(std::min(distance, AudioConfig::MAX_DISTANCE + 1.f));
+		}
+	}
+
+	// Voices entering or leaving the range are always reported, regardless of the thresholds, since they are muted
+	// beyond MAX_DISTANCE and would otherwise stay muted when coming back by less than DISTANCE_THRESHOLD.
+	bool hasMoved(const int channel) const
+	{
+		return appliedAngles[channel] == NOT_APPLIED ||
+		       std::abs(angles[channel] - appliedAngles[channel]) >= AudioConfig::ANGLE_THRESHOLD ||
+		       std::abs(distances[channel] - appliedDistances[channel]) >= AudioConfig::DISTANCE_THRESHOLD ||
+		       isInRange(distances[channel]) != isInRange(appliedDistances[channel]);
+	}
+
+	static bool isInRange(const int distance) { return distance <= AudioConfig::MAX_DISTANCE; }
+
+	// Polynomial approximation of std::atan2 (error below 0.1 degrees). The octant is folded in with arithmetic on the
+	// comparison results instead of selects, which gcc would not if-convert without -fno-trapping-math.
+	static float approximateAtan2(const float y, const float x)
+	{
+		const float absX = std::fabs(x);
+		const float absY = std::fabs(y);
+		const float difference = std::fabs(absX - absY);
+		const float ratio = (absX + absY - difference) / (absX + absY + difference + 1e-20f); // min / max
+		const float squared = ratio * ratio;
+		float angle = ((-0.0464964749f * squared + 0.15931422f) * squared - 0.327622764f) * squared * ratio + ratio;
+		angle += static_cast<float>(absY > absX) * (1.57079637f - 2.f * angle);
+		angle += static_cast<float>(x < 0.f) * (3.14159274f - 2.f * angle);
+		return std::copysign(angle, y);
+	}
+
+	// emitters, indexed by channel
+	std::array<float, AudioConfig::VIRTUAL_CHANNELS> positionsX;
+	std::array<float, AudioConfig::VIRTUAL_CHANNELS> positionsY;
+	std::array<float, AudioConfig::VIRTUAL_CHANNELS> distanceModifiers;
+	std::array<std::uint8_t, AudioConfig::VIRTUAL_CHANNELS> isActive;
+
+	// results of the last update and the values last handed to the mixer
+	std::array<int, AudioConfig::VIRTUAL_CHANNELS> angles;
+	std::array<int, AudioConfig::VIRTUAL_CHANNELS> distances;
+	std::array<int, AudioConfig::VIRTUAL_CHANNELS> appliedAngles;
+	std::array<int, AudioConfig::VIRTUAL_CHANNELS> appliedDistances;
+};
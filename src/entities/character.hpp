@@ -27,7 +27,7 @@ Easys::Entity instantiateBaseCharacter(Easys::ECS &ecs, Vec2i positionInTiles, R
 	             TILE_SIZE * BASE_ENTITY_HEIGHT}); // adding size here as currently all entities have the same size and
 	                                               // most entities will probably always be humans of size 2 anyway
 	ecs.addComponent(base, Rotatable{rotation});
-	ecs.addComponent(base, RigidBody{false, false, positionInTiles * TILE_SIZE, positionInTiles * TILE_SIZE});
+	ecs.addComponent(base, RigidBody{false, positionInTiles * TILE_SIZE, positionInTiles * TILE_SIZE});
 	ecs.addComponent(base, Animatable{PLAYER_STANDING_ANIMATION_NUMBER,
 	                                  {playerSpriteSheetY, playerSpriteSheetY + TILE_SIZE * BASE_ENTITY_HEIGHT,
 	                                   playerSpriteSheetY + 2 * TILE_SIZE * BASE_ENTITY_HEIGHT,
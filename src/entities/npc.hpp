@@ -2,6 +2,7 @@
 
 #include "../components/AI.hpp"
 #include "../components/EquippedWeapon.hpp"
+#include "../components/Hearing.hpp"
 #include "../components/Interactable.hpp"
 #include "../components/Pathfinding.hpp"
 #include "../components/Vision.hpp"
@@ -18,6 +19,7 @@ Easys::Entity instantiateNPCEntity(Easys::ECS &ecs, Vec2i positionInTiles, Rotat
 {
 	Easys::Entity npc = instantiateBaseCharacter(ecs, positionInTiles, rotation);
 	ecs.addComponent<Vision>(npc, Vision{});
+	ecs.addComponent<Hearing>(npc, Hearing{});
 	ecs.addComponent<AI>(npc, AI{positionInTiles * TILE_SIZE});
 	ecs.addComponent<Pathfinding>(npc, Pathfinding{});
 	ecs.addComponent(npc, Interactable{text});
@@ -3,11 +3,17 @@
 #include "../constants.hpp"
 #include "../modules/CSVDatabase.hpp"
 #include "WeaponMetadata.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 // Implemented as a singleton for easier access. These are only ever read from so i think this is a good choice.
+//
+// get() returns all data of a weapon and is meant for the UI. Systems which need a weapon every frame should use
+// getStats() instead, which indexes a dense array by weapon id instead of hashing and only holds the numbers.
 class WeaponDatabase : public CSVDatabase<WeaponID, WeaponMetadata> {
   public:
 	// Delete copy constructor and assignment operator to prevent copies
@@ -21,13 +27,38 @@ class WeaponDatabase : public CSVDatabase<WeaponID, WeaponMetadata> {
 		return instance;
 	}
 
+	// Throws std::out_of_range for ids which are not used by any weapon, like get() does.
+	const WeaponStats &getStats(const WeaponID id) const
+	{
+		if (!hasWeapon.at(id)) {
+			throw std::out_of_range("There is no weapon with id " + std::to_string(id) + ".");
+		}
+		return stats[id];
+	}
+
   private:
 	// Private constructor to enforce singleton pattern
-	WeaponDatabase(const std::string &filePath) : CSVDatabase<WeaponID, WeaponMetadata>(filePath, parseWeapon) {}
+	WeaponDatabase(const std::string &filePath) : CSVDatabase<WeaponID, WeaponMetadata>(filePath, parseWeapon)
+	{
+		WeaponID maxId = -1;
+		for (const auto &[id, weapon] : *this) {
+			if (id < 0) {
+				throw std::runtime_error("Weapon ids must not be negative.");
+			}
+			maxId = std::max(maxId, id);
+		}
+
+		stats.resize(maxId + 1);
+		hasWeapon.resize(maxId + 1, 0);
+		for (const auto &[id, weapon] : *this) {
+			stats[id] = weapon; // only copies the WeaponStats part
+			hasWeapon[id] = 1;
+		}
+	}
 
 	static std::pair<WeaponID, WeaponMetadata> parseWeapon(const std::vector<std::string> &tokens)
 	{
-		if (tokens.size() < 9) { // Ensure we have enough fields.
+		if (tokens.size() < 12) { // Ensure we have enough fields.
 			throw std::runtime_error("Not enough fields in line.");
 		}
 		WeaponMetadata wdata;
@@ -43,6 +74,7 @@ class WeaponDatabase : public CSVDatabase<WeaponID, WeaponMetadata> {
 			wdata.magazineSize = std::stoi(tokens[8]);
 			wdata.reloadTime = std::stof(tokens[9]);
 			wdata.spread = std::stof(tokens[10]);
+			wdata.hitscan = std::stoi(tokens[11]) != 0;
 		} catch (const std::invalid_argument &e) {
 			throw std::runtime_error("Invalid data format: " + std::string(e.what()));
 		} catch (const std::out_of_range &e) {
@@ -50,4 +82,7 @@ class WeaponDatabase : public CSVDatabase<WeaponID, WeaponMetadata> {
 		}
 		return {wdata.id, wdata};
 	}
+
+	std::vector<WeaponStats> stats;      // indexed by weapon id
+	std::vector<std::uint8_t> hasWeapon; // indexed by weapon id, 0 for ids no weapon uses
 };
@@ -4,13 +4,12 @@
 
 using WeaponID = int;
 
-struct WeaponMetadata {
-	WeaponID id;
-	std::string name;
-	std::string description;
-
+// The numbers needed while fighting. Kept apart from the strings, so systems can read them every frame without copying
+// strings (see WeaponDatabase::getStats()).
+struct WeaponStats {
 	float speed = 0;
 	float range = 0;
+	bool hitscan = false; // shots hit instantly instead of firing a projectile, speed is ignored
 
 	int damage = 0; // if we don't do different ammunition. otherwise we need a caliber member
 	int armorPenetration = 0;
@@ -33,4 +32,11 @@ struct WeaponMetadata {
 	                        - Do we want magazines? Different ammunition?
 	                        - Can weapons be modified?
 	                    */
+};
+
+// Everything about a weapon, including the texts shown in the UI.
+struct WeaponMetadata : WeaponStats {
+	WeaponID id;
+	std::string name;
+	std::string description;
 };
\ No newline at end of file
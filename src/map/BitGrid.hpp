@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../engine/types/Vec2i.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// A bit-packed boolean grid with one bit per tile. Rows are stored consecutively, so a 80x60 map fits into 75 words.
+// Used as a view of the map for queries, which only need to know if a tile blocks (e.g. line of sight).
+class BitGrid {
+  public:
+	BitGrid() = default;
+	BitGrid(int width, int height) : width(width), height(height), words((width * height + 63) / 64, 0) {}
+
+	bool get(int x, int y) const
+	{
+		const int index = y * width + x;
+		return (words[index >> 6] >> (index & 63)) & 1;
+	}
+	bool get(const Vec2i &position) const { return get(position.x, position.y); }
+
+	void set(int x, int y, bool value)
+	{
+		const int index = y * width + x;
+		const std::uint64_t bit = std::uint64_t{1} << (index & 63);
+		if (value)
+			words[index >> 6] |= bit;
+		else
+			words[index >> 6] &= ~bit;
+	}
+	void set(const Vec2i &position, bool value) { set(position.x, position.y, value); }
+
+	void clear() { std::fill(words.begin(), words.end(), std::uint64_t{0}); }
+
+	bool isInBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+	bool isInBounds(const Vec2i &position) const { return isInBounds(position.x, position.y); }
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+
+  private:
+	int width = 0, height = 0;
+	std::vector<std::uint64_t> words;
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "../constants.hpp"
+#include "../engine/types/Vec2f.hpp"
+#include "../engine/types/Vec2i.hpp"
+#include "../modules/Utils.hpp"
+#include "BitGrid.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// An open tile next to at least one blocking tile (wall, tree, rock).
+struct CoverPoint {
+	Vec2i tile;
+	std::uint8_t protection = 0; // bit (1 << Rotation) is set if the neighbour in that direction blocks
+
+	bool protectsFrom(Rotation direction) const { return protection & (1 << direction); }
+};
+
+// All cover points of a map, sorted into square buckets of BUCKET_SIZE tiles.
+//
+// Built once when a map is loaded. Searching for cover only visits the buckets around the searching tile, ring by
+// ring, and stops as soon as no bucket further out can contain a closer point. Changing a tile only recomputes that
+// tile and its neighbours (see update()).
+class CoverMap {
+  public:
+	static constexpr int BUCKET_SIZE = 8; // in tiles
+
+	void build(const BitGrid &obstacles)
+	{
+		width_ = obstacles.getWidth();
+		height_ = obstacles.getHeight();
+		bucketsX = (width_ + BUCKET_SIZE - 1) / BUCKET_SIZE;
+		bucketsY = (height_ + BUCKET_SIZE - 1) / BUCKET_SIZE;
+		buckets.assign(bucketsX * bucketsY, {});
+		pointCount = 0;
+
+		for (int y = 0; y < height_; y++) {
+			for (int x = 0; x < width_; x++) {
+				setProtection({x, y}, computeProtection(obstacles, {x, y}));
+			}
+		}
+	}
+
+	// Needs to be called after tile changed between blocking and open. Cover of a tile only depends on its direct
+	// neighbours, so only these are recomputed.
+	void update(const BitGrid &obstacles, const Vec2i &tile)
+	{
+		const Vec2i affected[] = {{0, 0}, {0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+		for (const Vec2i &offset : affected) {
+			const Vec2i neighbour = tile + offset;
+			if (obstacles.isInBounds(neighbour)) {
+				setProtection(neighbour, computeProtection(obstacles, neighbour));
+			}
+		}
+	}
+
+	// Returns the closest cover point to from (euclidean, in tiles) which protects from threat, or nothing if there is
+	// none within maxDistance.
+	std::optional<CoverPoint> findNearest(const Vec2i &from, const Vec2i &threat, int maxDistance) const
+	{
+		if (buckets.empty()) {
+			return std::nullopt;
+		}
+
+		const Vec2i origin{std::clamp(from.x, 0, width_ - 1) / BUCKET_SIZE,
+		                   std::clamp(from.y, 0, height_ - 1) / BUCKET_SIZE};
+		const int maxRing = std::max(bucketsX, bucketsY);
+
+		std::optional<CoverPoint> nearest;
+		int nearestDistance = maxDistance * maxDistance + 1; // squared, only closer points are accepted
+
+		for (int ring = 0; ring <= maxRing; ring++) {
+			// tiles in this ring are at least this far away from any tile of the origin bucket
+			const int minDistance = std::max(0, (ring - 1) * BUCKET_SIZE + 1);
+			if (minDistance * minDistance >= nearestDistance) {
+				break;
+			}
+
+			forEachBucketInRing(origin, ring, [&](const std::vector<CoverPoint> &bucket) {
+				for (const CoverPoint &point : bucket) {
+					const Vec2i offset = point.tile - from;
+					const int distance = offset.x * offset.x + offset.y * offset.y;
+					if (distance >= nearestDistance || point.tile == threat) {
+						continue;
+					}
+
+					const Vec2i toThreat = threat - point.tile;
+					if (point.protectsFrom(Utils::vec2fToRotation(Vec2f{float(toThreat.x), float(toThreat.y)}))) {
+						nearest = point;
+						nearestDistance = distance;
+					}
+				}
+			});
+		}
+
+		return nearest;
+	}
+
+	std::size_t size() const { return pointCount; }
+
+  private:
+	static std::uint8_t computeProtection(const BitGrid &obstacles, const Vec2i &tile)
+	{
+		if (obstacles.get(tile)) {
+			return 0;
+		}
+
+		std::uint8_t protection = 0;
+		for (const Rotation direction : {NORTH, EAST, SOUTH, WEST}) {
+			const Vec2i neighbour = tile + Utils::toInt(Utils::rotationToVec2f(direction));
+			if (obstacles.isInBounds(neighbour) && obstacles.get(neighbour)) {
+				protection |= 1 << direction;
+			}
+		}
+		return protection;
+	}
+
+	// Inserts, changes or removes the cover point of a tile. A protection of 0 means there is no cover.
+	void setProtection(const Vec2i &tile, const std::uint8_t protection)
+	{
+		std::vector<CoverPoint> &bucket = buckets[(tile.y / BUCKET_SIZE) * bucketsX + tile.x / BUCKET_SIZE];
+		auto it = std::find_if(bucket.begin(), bucket.end(), [&](const CoverPoint &p) { return p.tile == tile; });
+
+		if (it == bucket.end()) {
+			if (protection != 0) {
+				bucket.push_back({tile, protection});
+				pointCount++;
+			}
+		} else if (protection != 0) {
+			it->protection = protection;
+		} else {
+			*it = bucket.back();
+			bucket.pop_back();
+			pointCount--;
+		}
+	}
+
+	// Calls f(bucket) for every bucket with a chebyshev distance of ring to origin (all in bucket coordinates).
+	template <typename Function>
+	void forEachBucketInRing(const Vec2i &origin, int ring, Function &&f) const
+	{
+		for (int y = origin.y - ring; y <= origin.y + ring; y++) {
+			if (y < 0 || y >= bucketsY) {
+				continue;
+			}
+
+			const bool isEdgeRow = y == origin.y - ring || y == origin.y + ring;
+			const int step = isEdgeRow ? 1 : std::max(1, 2 * ring);
+			for (int x = origin.x - ring; x <= origin.x + ring; x += step) {
+				if (x >= 0 && x < bucketsX) {
+					f(buckets[y * bucketsX + x]);
+				}
+			}
+		}
+	}
+
+	int width_ = 0, height_ = 0;
+	int bucketsX = 0, bucketsY = 0;
+	std::vector<std::vector<CoverPoint>> buckets;
+	std::size_t pointCount = 0;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../engine/types/Vec2i.hpp"
+#include <cstdint>
+#include <vector>
+
+enum class FogState : std::uint8_t { Unexplored, Explored, Visible };
+
+// What the player's squad knows about each tile of the map.
+//
+// Every unit adds its visible tiles and removes them again when they leave its field of view, so each tile keeps a
+// count of units currently seeing it. A tile is Visible while that count is above zero and becomes Explored once it
+// drops back to zero. Updates only touch tiles whose visibility changed (see FogOfWarSystem).
+class FogOfWar {
+  public:
+	void reset(int width, int height)
+	{
+		width_ = width;
+		height_ = height;
+		states.assign(width * height, FogState::Unexplored);
+		viewerCounts.assign(width * height, 0);
+	}
+
+	void addViewer(const Vec2i &tile)
+	{
+		const int index = toIndex(tile);
+		viewerCounts[index]++;
+		states[index] = FogState::Visible;
+	}
+
+	void removeViewer(const Vec2i &tile)
+	{
+		const int index = toIndex(tile);
+		if (viewerCounts[index] > 0 && --viewerCounts[index] == 0) {
+			states[index] = FogState::Explored;
+		}
+	}
+
+	FogState getState(int x, int y) const { return states[y * width_ + x]; }
+	FogState getState(const Vec2i &tile) const { return getState(tile.x, tile.y); }
+
+	bool isVisible(const Vec2i &tile) const { return isInBounds(tile) && getState(tile) == FogState::Visible; }
+	bool isInBounds(const Vec2i &tile) const
+	{
+		return tile.x >= 0 && tile.x < width_ && tile.y >= 0 && tile.y < height_;
+	}
+
+	int getWidth() const { return width_; }
+	int getHeight() const { return height_; }
+
+  private:
+	int toIndex(const Vec2i &tile) const { return tile.y * width_ + tile.x; }
+
+	int width_ = 0, height_ = 0;
+	std::vector<FogState> states;
+	std::vector<std::uint16_t> viewerCounts;
+};
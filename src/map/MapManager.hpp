@@ -1,9 +1,12 @@
 #pragma once
 
 #include "../constants.hpp"
+#include "BitGrid.hpp"
+#include "CoverMap.hpp"
 #include "LevelMap.hpp"
 #include "MapLoader.hpp"
 #include "TileRegistry.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -21,6 +24,10 @@ class MapManager {
 
 		// create views
 		walkableView = createWalkableMapView(levelMap);
+		obstacleGrid = createObstacleGrid(walkableView);
+		impenetrableGrid = createImpenetrableGrid(levelMap);
+		obstacleVersion++;
+		coverMap.build(obstacleGrid);
 	}
 
 	const LevelMap &getLevelMap() const { return levelMap; }
@@ -29,30 +36,12 @@ class MapManager {
 
 	std::vector<std::vector<int>> createWalkableMapView(const LevelMap &map)
 	{
-		const Layer &backgroundLayer = map.getLayer(LayerID::BACKGROUND);
-		const Layer &background2Layer = map.getLayer(LayerID::BACKGROUND2);
-		const Layer &objectLayer = map.getLayer(LayerID::OBJECT);
-		const Layer &object2Layer = map.getLayer(LayerID::OBJECT2);
 		std::vector<std::vector<int>> walkableMapView;
 
 		for (int y = 0; y < map.getHeight(); y++) {
 			walkableMapView.push_back({});
 			for (int x = 0; x < map.getWidth(); x++) {
-				int tileIndex = Utils::to1d({x, y}, map.getWidth());
-				TileMetadata backgroundData = getTileData(backgroundLayer[tileIndex]);
-				TileMetadata objectData = getTileData(objectLayer[tileIndex]);
-				TileMetadata background2Data = getTileData(background2Layer[tileIndex]);
-				TileMetadata object2Data = getTileData(object2Layer[tileIndex]);
-
-				// TODO: refactor and redesign
-				if (object2Data.id != 0)
-					walkableMapView[y].push_back(!object2Data.walkable);
-				else if (objectData.id != 0)
-					walkableMapView[y].push_back(!objectData.walkable);
-				else if (background2Data.id != 0)
-					walkableMapView[y].push_back(!background2Data.walkable);
-				else
-					walkableMapView[y].push_back(!backgroundData.walkable);
+				walkableMapView[y].push_back(!getTopmostTileData(map, {x, y}).walkable);
 				std::cout << walkableMapView[y][x];
 			}
 			std::cout << std::endl;
@@ -60,11 +49,55 @@ class MapManager {
 		return walkableMapView;
 	}
 
+	// Tiles which stop projectiles, see TileMetadata::penetrable.
+	BitGrid createImpenetrableGrid(const LevelMap &map) const
+	{
+		BitGrid grid(map.getWidth(), map.getHeight());
+		for (int y = 0; y < map.getHeight(); y++) {
+			for (int x = 0; x < map.getWidth(); x++) {
+				grid.set(x, y, !getTopmostTileData(map, {x, y}).penetrable);
+			}
+		}
+		return grid;
+	}
+
+	BitGrid createObstacleGrid(const std::vector<std::vector<int>> &walkableMapView) const
+	{
+		BitGrid grid(levelMap.getWidth(), levelMap.getHeight());
+		for (int y = 0; y < levelMap.getHeight(); y++) {
+			for (int x = 0; x < levelMap.getWidth(); x++) {
+				grid.set(x, y, walkableMapView[y][x] != 0);
+			}
+		}
+		return grid;
+	}
+
 	// for single entries, we could directly check. But i think decoupling everything from mapmanager makes sense.
 	const std::vector<std::vector<int>> &getWalkableMapView() const { return walkableView; }
 	int getWalkableMapView(int x, int y) const { return walkableView[y][x]; }
+	// Bit-packed version of the walkable view, where a set bit marks a blocking tile.
+	const BitGrid &getObstacleGrid() const { return obstacleGrid; }
+	// Same for projectiles, a set bit marks a tile which stops them.
+	const BitGrid &getImpenetrableGrid() const { return impenetrableGrid; }
+	// Changes whenever the obstacle grid changes, so results computed from it can be cached.
+	std::uint64_t getObstacleVersion() const { return obstacleVersion; }
+	// Open tiles next to blocking ones, precomputed on map load.
+	const CoverMap &getCoverMap() const { return coverMap; }
 
   private:
+	// The properties of a tile are the ones of the topmost layer which has a tile there.
+	const TileMetadata &getTopmostTileData(const LevelMap &map, const Vec2i &tile) const
+	{
+		const int tileIndex = Utils::to1d(tile, map.getWidth());
+		for (const LayerID layer : {LayerID::OBJECT2, LayerID::OBJECT, LayerID::BACKGROUND2}) {
+			const TileMetadata &data = getTileData(map.getLayer(layer)[tileIndex]);
+			if (data.id != 0) {
+				return data;
+			}
+		}
+		return getTileData(map.getLayer(LayerID::BACKGROUND)[tileIndex]);
+	}
+
 	void printMap(const LevelMap &map) const
 	{
 		int layerIndex = 0;
@@ -85,4 +118,8 @@ class MapManager {
 
 	// views
 	std::vector<std::vector<int>> walkableView;
+	BitGrid obstacleGrid;
+	BitGrid impenetrableGrid;
+	std::uint64_t obstacleVersion = 0;
+	CoverMap coverMap;
 };
\ No newline at end of file
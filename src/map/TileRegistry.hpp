@@ -1,9 +1,12 @@
 #pragma once
 
+#include "../constants.hpp"
+#include "../modules/CSVDatabase.hpp"
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -15,6 +18,7 @@
 struct TileMetadata {
 	int id = 0;
 	bool walkable;
+	bool penetrable; // projectiles fly through (e.g. shrubs), walls and rocks stop them
 };
 
 class TileRegistry : public CSVDatabase<int, TileMetadata> {
@@ -33,11 +37,19 @@ class TileRegistry : public CSVDatabase<int, TileMetadata> {
 		}
 	}
 
-  private:
-	TileMetadata fallbackSprite{0, true}; // Default fallback sprite
-
+	// A row is id, walkable and penetrable. Files without the penetrable column (older or third party ones) are
+	// accepted, those tiles stop projectiles exactly if they block movement.
 	static std::pair<int, TileMetadata> parseRow(const std::vector<std::string> &tokens)
 	{
-		return {std::stoi(tokens[0]), TileMetadata{std::stoi(tokens[0]), std::stoi(tokens[1]) == 1}};
+		if (tokens.size() < 2) {
+			throw std::runtime_error("Not enough fields in tile properties line.");
+		}
+		const int id = std::stoi(tokens[0]);
+		const bool walkable = std::stoi(tokens[1]) == 1;
+		const bool penetrable = tokens.size() > 2 ? std::stoi(tokens[2]) == 1 : walkable;
+		return {id, TileMetadata{id, walkable, penetrable}};
 	}
+
+  private:
+	TileMetadata fallbackSprite{0, true, true}; // Default fallback sprite
 };
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../engine/types/Rectf.hpp"
+#include "../engine/types/Vec2f.hpp"
+#include <algorithm>
+#include <optional>
 
 namespace AABB {
 bool checkCollision(const Rectf &a, const Rectf &b)
@@ -16,4 +19,38 @@ bool checkCollision(const Rectf &a, const Rectf &b)
 	// Otherwise, there is a collision
 	return true;
 }
+
+// Moves a by delta and returns the fraction of delta (0 to 1) after which it first touches b, or nothing if it does
+// not. Boxes which already overlap collide at 0. Fast moving boxes cannot tunnel through b, unlike when checking the
+// start and end positions only.
+std::optional<float> sweep(const Rectf &a, const Vec2f &delta, const Rectf &b)
+{
+	// Grows b by the size of a, so a can be treated as a point moving along a segment.
+	const float origin[2] = {a.x, a.y};
+	const float direction[2] = {delta.x, delta.y};
+	const float min[2] = {b.x - a.w, b.y - a.h};
+	const float max[2] = {b.x + b.w, b.y + b.h};
+
+	float entry = 0.0f;
+	float exit = 1.0f;
+	for (int axis = 0; axis < 2; axis++) {
+		if (direction[axis] == 0.0f) {
+			if (origin[axis] < min[axis] || origin[axis] > max[axis])
+				return std::nullopt;
+			continue;
+		}
+
+		float near = (min[axis] - origin[axis]) / direction[axis];
+		float far = (max[axis] - origin[axis]) / direction[axis];
+		if (near > far)
+			std::swap(near, far);
+
+		entry = std::max(entry, near);
+		exit = std::min(exit, far);
+		if (entry > exit)
+			return std::nullopt;
+	}
+
+	return entry;
+}
 } // namespace AABB
\ No newline at end of file
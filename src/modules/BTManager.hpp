@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../ai/BTCompiler.hpp"
+#include "../ai/BTExecutor.hpp"
 #include "../ai/nodes/IsEnemyVisible.hpp"
 #include "../ai/nodes/IsInState.hpp"
 #include "../ai/nodes/MoveTo.hpp"
@@ -9,42 +11,135 @@
 #include "../ai/nodes/TurnTo.hpp"
 #include "../ai/nodes/WaitFor.hpp"
 #include "../constants.hpp"
+#include "EntityHandle.hpp"
 #include "behaviortree_cpp/bt_factory.h"
 #include <easys/easys.hpp>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
+// Every tree has its own blackboard with the values of its entity ("entity", and "deltaTime", which is written when the
+// tree is ticked).
+//
+// With BT_COMPILE_TREES, trees are compiled into a BTExecutor the first time they are used. All entities running the
+// same tree share its executor. Trees the compiler does not support (e.g. RandomSelector) fall back to
+// BehaviorTree.CPP.
+//
+// Trees are released when their entity dies (see CleanupSystem). A compiled tree is only a block of per-entity state in
+// its executor, which keeps the memory for the next entity. BehaviorTree.CPP trees are halted and kept in a pool per
+// tree name, so spawning an entity reuses the nodes and blackboards of a dead one instead of instantiating them again.
+// The blackboards are cleared on reuse, so the new entity does not see values written for the dead one.
 class BTManager {
   public:
-	explicit BTManager(Easys::ECS &ecs)
+	BTManager(Easys::ECS &ecs_, const EntityGenerations &generations_, const std::string &treeDirectory = BT_DIRECTORY)
+	    : ecs(ecs_), generations(generations_)
 	{
 		registerNodes(ecs);
-		registerTreesFromDirectory(BT_DIRECTORY);
+		registerTreesFromDirectory(treeDirectory);
 	}
 
 	void createTreeForEntity(const Easys::Entity &entity, const std::string &treeName)
 	{
-		// TODO?: if entity has tree
-		auto tree = factory.createTree(treeName);
+		removeTreeForEntity(entity);
+
+		if (BTExecutor *executor = getExecutor(treeName)) {
+			executor->addInstance(entity);
+			compiledTrees[entity] = executor;
+			return;
+		}
+
+		std::vector<BT::Tree> &released = releasedTrees[treeName];
+		if (!released.empty()) {
+			BT::Tree tree = std::move(released.back());
+			released.pop_back();
+			// e.g. MoveTo in EngageTree reads otherPosition when IsEnemyVisible fails, which would be the last
+			// sighting of the dead entity. Remappings of subtrees are not entries, so they survive clearing.
+			for (const BT::Tree::Subtree::Ptr &subtree : tree.subtrees) {
+				subtree->blackboard->clear();
+			}
+			tree.rootBlackboard()->set("entity", entity);
+			tree.rootBlackboard()->set("deltaTime", 0.0);
+			trees.emplace(entity, FallbackTree{treeName, std::move(tree)});
+			return;
+		}
+
+		BT::Tree tree = factory.createTree(treeName);
 		tree.rootBlackboard()->set("entity", entity);
 		tree.rootBlackboard()->set("deltaTime", 0.0);
-		trees[entity] = std::move(tree);
+		trees.emplace(entity, FallbackTree{treeName, std::move(tree)});
 	}
 
-	void tickTree(Easys::Entity entity)
+	// Releases the tree of an entity so it can be reused. Does nothing if the entity has no tree.
+	void removeTreeForEntity(const Easys::Entity &entity)
 	{
-		trees[entity].tickOnce();
+		auto it = trees.find(entity);
+		if (it != trees.end()) {
+			// Halting resets every node, the blackboards are cleared when the tree is reused.
+			it->second.tree.haltTree();
+			releasedTrees[it->second.name].push_back(std::move(it->second.tree));
+			trees.erase(it);
+		}
+
+		auto compiled = compiledTrees.find(entity);
+		if (compiled != compiledTrees.end()) {
+			compiled->second->removeInstance(entity);
+			compiledTrees.erase(compiled);
+		}
 	}
 
-	// Set a value globally for every entity.
-	template <typename T>
-	void setGlobalTreeValue(const std::string &key, const T &value)
+	// Compiled trees can be ticked from several threads at once, see AICommands.
+	bool hasCompiledTree(Easys::Entity entity) const { return compiledTrees.count(entity) > 0; }
+
+	// Only for compiled trees. Their writes are recorded in commands instead of changing the ECS.
+	void tickCompiledTree(Easys::Entity entity, double deltaTime, AICommands &commands)
 	{
-		for (auto &[entity, tree] : trees) {
-			tree.rootBlackboard()->set(key, value); // propagate deltaTime to all nodes
+		compiledTrees.at(entity)->tick(entity, deltaTime, commands);
+	}
+
+	// deltaTime is the time since this tree was last ticked, which differs between trees (see AIScheduler). So it cannot
+	// be shared through a parent blackboard and is written per tree: into a typed slot for compiled trees, by key only
+	// for trees falling back to BehaviorTree.CPP.
+	void tickTree(Easys::Entity entity, double deltaTime)
+	{
+		auto it = compiledTrees.find(entity);
+		if (it != compiledTrees.end()) {
+			it->second->tick(entity, deltaTime);
+			return;
 		}
+
+		BT::Tree &tree = trees.at(entity).tree;
+		tree.rootBlackboard()->set("deltaTime", deltaTime);
+		tree.tickOnce();
 	}
 
   private:
+	struct FallbackTree {
+		std::string name;
+		BT::Tree tree;
+	};
+
+	// Returns nullptr if the tree should run with BehaviorTree.CPP.
+	BTExecutor *getExecutor(const std::string &treeName)
+	{
+		if (!BT_COMPILE_TREES) {
+			return nullptr;
+		}
+
+		auto it = executors.find(treeName);
+		if (it == executors.end()) {
+			std::unique_ptr<BTExecutor> executor;
+			try {
+				executor = std::make_unique<BTExecutor>(ecs, generations, compiler.compile(treeName));
+			} catch (const std::runtime_error &e) {
+				std::cout << "Could not compile tree " << treeName << ": " << e.what() << "\n";
+			}
+			it = executors.emplace(treeName, std::move(executor)).first;
+		}
+		return it->second.get();
+	}
+
 	void registerNodes(Easys::ECS &ecs)
 	{
 		factory.registerNodeType<RandomSelector>("RandomSelector");
@@ -53,7 +148,7 @@ class BTManager {
 		factory.registerNodeType<IsInState>("IsInState", std::ref(ecs));
 		factory.registerNodeType<MoveTo>("MoveTo", std::ref(ecs));
 		factory.registerNodeType<PatrolTo>("PatrolTo", std::ref(ecs));
-		factory.registerNodeType<ShootAt>("ShootAt", std::ref(ecs));
+		factory.registerNodeType<ShootAt>("ShootAt", std::ref(ecs), std::cref(generations));
 		factory.registerNodeType<TurnTo>("TurnTo", std::ref(ecs));
 		factory.registerNodeType<WaitFor>("WaitFor", std::ref(ecs));
 	}
@@ -66,12 +161,20 @@ class BTManager {
 			if (entry.path().extension() == ".xml") {
 				std::cout << entry.path().string() << "\n";
 				factory.registerBehaviorTreeFromFile(entry.path().string());
+				compiler.registerTreesFromFile(entry.path().string());
 			}
 		}
 	}
 
+	Easys::ECS &ecs;
+	const EntityGenerations &generations;
 	BT::BehaviorTreeFactory factory;
-	std::unordered_map<Easys::Entity, BT::Tree> trees;
+	std::unordered_map<Easys::Entity, FallbackTree> trees;
+	std::unordered_map<std::string, std::vector<BT::Tree>> releasedTrees; // halted trees of dead entities by name
+
+	BTCompiler compiler;
+	std::unordered_map<std::string, std::unique_ptr<BTExecutor>> executors; // nullptr if the tree did not compile
+	std::unordered_map<Easys::Entity, BTExecutor *> compiledTrees;
 	// It might be preferable to store the tree in a component (dedicated or else) so we keep all game state within the
 	// ecs. This would make saving and loading (more) straight forward. Otherwise we would have to manually handle
 	// loading and saving the btmanager and pass a ref to some places (menus, savegamemanager).
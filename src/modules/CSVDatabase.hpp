@@ -37,6 +37,9 @@ class CSVDatabase {
 
 	std::size_t size() const { return db.size(); }
 
+	typename std::unordered_map<KeyType, ElementType>::const_iterator begin() const { return db.begin(); }
+	typename std::unordered_map<KeyType, ElementType>::const_iterator end() const { return db.end(); }
+
 	// TODO: could we try something like this, where we let the user override an abstract parse function instead of passing a function of type RowParserType?
 	// Technically this should probably be overwritten for the CSVParser, if we keep CSVParser separate.
 	// static std::pair<KeyType, ElementType> parse(const std::vector<std::string> &tokens) = 0;
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "EntityHandle.hpp"
+#include "Query.hpp"
+#include <atomic>
+#include <cstddef>
+#include <easys/easys.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Records structural changes to the ECS (adding and removing components and entities) and applies them later in bulk.
+//
+// Systems record their changes while iterating the ECS instead of applying them right away, so they never modify the
+// storage they are iterating and need no defensive copies of the entity set. The game plays the buffer back at fixed
+// sync points between systems (see Game::update), in the order the changes were recorded.
+//
+// Recorded components are kept in one pool per type and the log only stores an index into it, so recording does not
+// allocate once the pools have grown to their usual size.
+//
+// Every entity touched during playback is reported to the QueryRegistry, so the queries stay up to date. Removed
+// entities are reported to the EntityGenerations, which invalidates all handles to them.
+class CommandBuffer {
+  public:
+	CommandBuffer() = default;
+	explicit CommandBuffer(QueryRegistry &queries) : queries_(&queries) {}
+	CommandBuffer(QueryRegistry &queries, EntityGenerations &generations)
+	    : queries_(&queries), generations_(&generations)
+	{
+	}
+
+	template <typename T>
+	void addComponent(const Easys::Entity entity, T component)
+	{
+		std::vector<T> &components = getPool<T>().components;
+		log.push_back({&applyAddComponent<T>, entity, components.size()});
+		components.push_back(std::move(component));
+	}
+
+	template <typename T>
+	void removeComponent(const Easys::Entity entity)
+	{
+		log.push_back({&applyRemoveComponent<T>, entity, 0});
+	}
+
+	void removeEntity(const Easys::Entity entity) { log.push_back({&applyRemoveEntity, entity, 0}); }
+
+	// Changes to entities which were removed in the meantime are skipped, as are removals of missing components.
+	void playback(Easys::ECS &ecs)
+	{
+		for (const Command &command : log) {
+			command.apply(*this, ecs, command);
+			if (queries_)
+				queries_->update(command.entity);
+		}
+
+		log.clear();
+		for (const auto &pool : pools) {
+			if (pool)
+				pool->clear();
+		}
+	}
+
+	bool isEmpty() const { return log.empty(); }
+	std::size_t size() const { return log.size(); }
+
+  private:
+	struct Command {
+		void (*apply)(CommandBuffer &, Easys::ECS &, const Command &);
+		Easys::Entity entity;
+		std::size_t index; // into the pool of the component type
+	};
+
+	struct PoolBase {
+		virtual ~PoolBase() = default;
+		virtual void clear() = 0;
+	};
+
+	template <typename T>
+	struct Pool final : PoolBase {
+		std::vector<T> components;
+		void clear() override { components.clear(); }
+	};
+
+	template <typename T>
+	Pool<T> &getPool()
+	{
+		// same for every buffer. Buffers of different worlds record concurrently (see CombatSimulator), so two types may
+		// take their id at the same time.
+		static const std::size_t id = nextPoolId.fetch_add(1);
+		if (id >= pools.size()) {
+			pools.resize(id + 1);
+		}
+		if (!pools[id]) {
+			pools[id] = std::make_unique<Pool<T>>();
+		}
+		return static_cast<Pool<T> &>(*pools[id]);
+	}
+
+	template <typename T>
+	static void applyAddComponent(CommandBuffer &buffer, Easys::ECS &ecs, const Command &command)
+	{
+		if (ecs.hasEntity(command.entity)) {
+			ecs.addComponent<T>(command.entity, std::move(buffer.getPool<T>().components[command.index]));
+		}
+	}
+
+	template <typename T>
+	static void applyRemoveComponent(CommandBuffer &, Easys::ECS &ecs, const Command &command)
+	{
+		if (ecs.hasEntity(command.entity) && ecs.hasComponent<T>(command.entity)) {
+			ecs.removeComponent<T>(command.entity);
+		}
+	}
+
+	static void applyRemoveEntity(CommandBuffer &buffer, Easys::ECS &ecs, const Command &command)
+	{
+		if (ecs.hasEntity(command.entity)) {
+			ecs.removeEntity(command.entity);
+			if (buffer.generations_)
+				buffer.generations_->onRemoved(command.entity);
+		}
+	}
+
+	inline static std::atomic<std::size_t> nextPoolId = 0;
+
+	QueryRegistry *queries_ = nullptr;
+	EntityGenerations *generations_ = nullptr;
+	std::vector<Command> log;
+	std::vector<std::unique_ptr<PoolBase>> pools; // indexed by pool id
+};
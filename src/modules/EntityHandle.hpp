@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <easys/easys.hpp>
+#include <vector>
+
+// A reference to an entity which is kept across frames (e.g. the entity a Target points at).
+//
+// Easys hands out the ids of removed entities again, so a raw Easys::Entity held for a while may end up naming a
+// different entity. A handle also remembers the generation its id had when the handle was taken, so a stale handle is
+// detected by comparing it against the current generation (see EntityGenerations).
+struct EntityHandle {
+	Easys::Entity entity = 0;
+	std::uint32_t generation = 0;
+
+	bool operator==(const EntityHandle &other) const = default;
+};
+
+// The current generation of every entity id.
+//
+// A generation is incremented when its entity is removed, which CommandBuffer::playback reports here. Every handle
+// taken before the removal is stale from then on, even if a new entity gets the same id. Validating a handle is a
+// single array access and needs no lookup in the ECS.
+//
+// Loading a save game replaces every entity at once, so SaveGameManager::load calls invalidateAll. Handles must only be
+// taken of living entities, and entities must not be removed directly through the ECS, since that is not reported.
+class EntityGenerations {
+  public:
+	EntityHandle getHandle(const Easys::Entity entity) const { return {entity, getGeneration(entity)}; }
+
+	bool isValid(const EntityHandle &handle) const { return handle.generation == getGeneration(handle.entity); }
+
+	void onRemoved(const Easys::Entity entity)
+	{
+		if (entity >= generations.size()) {
+			generations.resize(entity + 1, 0);
+		}
+		generations[entity]++;
+	}
+
+	// Makes every handle taken so far stale. Generations only ever increase, so no stale handle becomes valid again.
+	void invalidateAll() { epoch++; }
+
+	std::uint32_t getGeneration(const Easys::Entity entity) const
+	{
+		return epoch + (entity < generations.size() ? generations[entity] : 0);
+	}
+
+  private:
+	std::vector<std::uint32_t> generations; // indexed by entity, ids which were never removed are 0
+	std::uint32_t epoch = 0;                // added to every generation, incremented by invalidateAll
+};
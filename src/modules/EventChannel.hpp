@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <easys/easys.hpp>
+#include <vector>
+
+// Events of one type (e.g. damage dealt to entities), passed from the systems producing them to the systems consuming
+// them without adding and removing components every frame.
+//
+// The channel is double buffered: producers push to a pending buffer while consumers read the published buffer.
+// publish() is called once per frame at a fixed point (see the sync points in Game::onUpdate) and replaces the
+// published events with the pending ones. Both buffers keep their capacity, so a channel stops allocating once it saw
+// its busiest frame.
+//
+// Every event has an `entity` member naming the entity it is about. Published events are sorted by entity, so
+// consumers can handle all events of an entity at once (see forEachEntity()). Events of the same entity keep the order
+// they were pushed in.
+template <typename Event>
+class EventChannel {
+  public:
+	void push(const Event &event) { pending.push_back(event); }
+
+	template <typename Iterator>
+	void append(Iterator first, Iterator last)
+	{
+		pending.insert(pending.end(), first, last);
+	}
+
+	void publish()
+	{
+		std::swap(pending, published);
+		pending.clear();
+		std::stable_sort(published.begin(), published.end(),
+		                 [](const Event &a, const Event &b) { return a.entity < b.entity; });
+	}
+
+	// Calls f(entity, first, last) once for every entity with published events, [first, last) being its events.
+	template <typename Function>
+	void forEachEntity(Function &&f) const
+	{
+		auto first = published.begin();
+		while (first != published.end()) {
+			const Easys::Entity entity = first->entity;
+			auto last = std::find_if(first, published.end(), [entity](const Event &e) { return e.entity != entity; });
+			f(entity, first, last);
+			first = last;
+		}
+	}
+
+	typename std::vector<Event>::const_iterator begin() const { return published.begin(); }
+	typename std::vector<Event>::const_iterator end() const { return published.end(); }
+	std::size_t size() const { return published.size(); }
+	bool empty() const { return published.empty(); }
+
+	void clear()
+	{
+		pending.clear();
+		published.clear();
+	}
+
+  private:
+	std::vector<Event> pending;
+	std::vector<Event> published;
+};
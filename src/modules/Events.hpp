@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../components/Noise.hpp"
+#include "../engine/types/Vec2f.hpp"
+#include "EventChannel.hpp"
+#include <easys/easys.hpp>
+
+// Damage to be applied to an entity by the DamageSystem.
+struct DamageEvent {
+	Easys::Entity entity = 0; // entity receiving the damage
+	Easys::Entity source = 0; // entity dealing the damage
+	int amount = 0;
+};
+
+// A sound made by an entity. It is played by the AudioSystem and heard by the AI (see AIPerceptionSystem).
+struct SoundEvent {
+	Easys::Entity entity = 0; // entity making the sound
+	Vec2f position;           // in pixels, the entity might be gone by the time the sound is heard
+	NoiseType type;
+	int loudness; // in tiles, how far the noise travels over open ground
+};
+
+// Asks the CleanupSystem to remove an entity.
+struct DestroyRequest {
+	Easys::Entity entity = 0;
+};
+
+// All event channels, owned by the game and passed to the systems which produce or consume events.
+struct Events {
+	EventChannel<DamageEvent> damage;
+	EventChannel<SoundEvent> sounds;
+	EventChannel<DestroyRequest> destroy;
+
+	void clear()
+	{
+		damage.clear();
+		sounds.clear();
+		destroy.clear();
+	}
+};
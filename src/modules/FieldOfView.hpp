@@ -0,0 +1,159 @@
+#pragma once
+
+#include "../engine/types/Vec2f.hpp"
+#include "../engine/types/Vec2i.hpp"
+#include "../map/BitGrid.hpp"
+#include "ViewCone.hpp"
+
+// The set of tiles visible from an origin tile, computed with recursive shadowcasting.
+//
+// Only a square window of (2 * radius + 1)^2 bits around the origin is stored, so the memory does not depend on the map
+// size. Once computed, checking if a tile is visible is a single bit test. The result stays valid until the origin,
+// direction or obstacles change, so callers should only recompute when needed (see isComputedFor()).
+//
+// Tiles are visible if their center is within radius and inside the cone. Blocking tiles are visible themselves, but
+// hide everything behind them. Tiles outside the map are treated as blocking.
+class FieldOfView {
+  public:
+	// radius in tiles, angle is the full field of view in degrees (see Vision component).
+	void compute(const BitGrid &obstacles, const Vec2i &origin, int radius, const Vec2f &forward, float angle)
+	{
+		origin_ = origin;
+		radius_ = radius;
+		forward_ = forward;
+		angle_ = angle;
+		if (window.getWidth() != 2 * radius + 1) {
+			window = BitGrid(2 * radius + 1, 2 * radius + 1);
+		} else {
+			window.clear();
+		}
+
+		if (!obstacles.isInBounds(origin)) {
+			return;
+		}
+
+		cone = ViewCone::makeParams({0, 0}, forward, static_cast<float>(radius), angle);
+		window.set(radius, radius, true);
+
+		for (const Octant &octant : octants) {
+			if (isOctantInCone(octant)) {
+				castLight(obstacles, octant, 1, 1.0f, 0.0f);
+			}
+		}
+	}
+
+	bool isVisible(const Vec2i &tile) const
+	{
+		const int x = tile.x - origin_.x + radius_;
+		const int y = tile.y - origin_.y + radius_;
+		return window.isInBounds(x, y) && window.get(x, y);
+	}
+
+	// Calls callback(tile) for every visible tile.
+	template <typename Callback>
+	void forEachVisible(Callback &&callback) const
+	{
+		for (int y = 0; y < window.getHeight(); y++) {
+			for (int x = 0; x < window.getWidth(); x++) {
+				if (window.get(x, y)) {
+					callback(Vec2i{origin_.x + x - radius_, origin_.y + y - radius_});
+				}
+			}
+		}
+	}
+
+	bool isComputedFor(const Vec2i &origin, int radius, const Vec2f &forward, float angle) const
+	{
+		return radius_ >= 0 && origin_ == origin && radius_ == radius && forward_ == forward && angle_ == angle;
+	}
+
+	// Forces the next isComputedFor() check to fail, e.g. after the obstacles changed.
+	void invalidate() { radius_ = -1; }
+
+	const Vec2i &getOrigin() const { return origin_; }
+	int getRadius() const { return radius_; }
+
+  private:
+	// Maps the octant local (column, row) coordinates to map offsets: x = col * xx + row * xy, y = col * yx + row * yy
+	struct Octant {
+		int xx, xy, yx, yy;
+	};
+
+	static constexpr Octant octants[8] = {{1, 0, 0, 1},  {0, 1, 1, 0},  {0, -1, 1, 0}, {-1, 0, 0, 1},
+	                                      {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}};
+
+	// Scans the rows of an octant outwards, between the slopes start and end. A blocking tile splits the scan: the part
+	// before it continues in a recursive call, the part after it continues once the blocking tiles end.
+	void castLight(const BitGrid &obstacles, const Octant &octant, int row, float start, float end)
+	{
+		if (start < end) {
+			return;
+		}
+
+		float nextStart = start;
+		for (int distance = row; distance <= radius_; distance++) {
+			bool blocked = false;
+
+			for (int col = -distance; col <= 0; col++) {
+				const int dy = -distance;
+				const float leftSlope = (col - 0.5f) / (dy + 0.5f);
+				const float rightSlope = (col + 0.5f) / (dy - 0.5f);
+				if (start < rightSlope) {
+					continue;
+				}
+				if (end > leftSlope) {
+					break;
+				}
+
+				const Vec2i offset{col * octant.xx + dy * octant.xy, col * octant.yx + dy * octant.yy};
+				const Vec2i tile = origin_ + offset;
+				const bool isBlocking = !obstacles.isInBounds(tile) || obstacles.get(tile);
+
+				if (obstacles.isInBounds(tile) && ViewCone::isInside(cone, {float(offset.x), float(offset.y)})) {
+					window.set(offset.x + radius_, offset.y + radius_, true);
+				}
+
+				if (blocked) {
+					if (isBlocking) {
+						nextStart = rightSlope;
+					} else {
+						blocked = false;
+						start = nextStart;
+					}
+				} else if (isBlocking && distance < radius_) {
+					blocked = true;
+					castLight(obstacles, octant, distance + 1, start, leftSlope);
+					nextStart = rightSlope;
+				}
+			}
+
+			if (blocked) {
+				break;
+			}
+		}
+	}
+
+	// Octants completely outside the cone are skipped. An octant is the 45 degree wedge between its two edges.
+	bool isOctantInCone(const Octant &octant) const
+	{
+		const Vec2f edgeA = Vec2f{float(-octant.xy), float(-octant.yy)};
+		const Vec2f edgeB = Vec2f{float(-octant.xx - octant.xy), float(-octant.yx - octant.yy)}.norm();
+		if (ViewCone::isInside(cone, edgeA) || ViewCone::isInside(cone, edgeB)) {
+			return true;
+		}
+
+		// the cone is narrower than the wedge and lies inside of it
+		const Vec2f &f = cone.forward;
+		const float crossAB = edgeA.x * edgeB.y - edgeA.y * edgeB.x;
+		const float crossAF = edgeA.x * f.y - edgeA.y * f.x;
+		const float crossFB = f.x * edgeB.y - f.y * edgeB.x;
+		return crossAF * crossAB >= 0 && crossFB * crossAB >= 0 && f.dot(edgeA + edgeB) > 0;
+	}
+
+	Vec2i origin_{0, 0};
+	int radius_ = -1;
+	Vec2f forward_{0, 0};
+	float angle_ = 0;
+	ViewConeParams cone{};
+	BitGrid window;
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "../components/Positionable.hpp"
+#include "../constants.hpp"
+#include "../engine/types/Rectf.hpp"
+#include "../engine/types/Vec2f.hpp"
+#include "../map/BitGrid.hpp"
+#include "AABB.hpp"
+#include "LineOfSight.hpp"
+#include <algorithm>
+#include <cmath>
+#include <easys/easys.hpp>
+#include <optional>
+#include <vector>
+
+struct HitscanShot {
+	Easys::Entity shooter = 0;
+	Vec2f from;
+	Vec2f to; // end of the weapon's range
+	int damage = 0;
+};
+
+struct HitscanHit {
+	Easys::Entity shooter = 0;
+	Easys::Entity target = 0;
+	Vec2f position;
+	int damage = 0;
+};
+
+// Collects the shots of hitscan weapons during a frame and resolves them together.
+//
+// Instead of testing every shot against every collider, resolve() sorts the colliders into a coarse grid of cells once
+// and then walks each shot through the cells it crosses, so a shot is only tested against the colliders close to its
+// path. The first tile which is not penetrable stops a shot, like it stops projectiles. Nothing is kept between frames:
+// the batch is empty again after resolve().
+class HitscanBatch {
+  public:
+	static constexpr int CELL_SIZE = 4; // in tiles
+
+	void add(const HitscanShot &shot) { shots.push_back(shot); }
+
+	bool empty() const { return shots.empty(); }
+
+	// Colliders is a range of entities with a Positionable, e.g. a Query<Collider, Positionable>. Returns the first
+	// entity hit by each shot, if any. Shots never hit their shooter.
+	template <typename Colliders>
+	const std::vector<HitscanHit> &resolve(Easys::ECS &ecs, const BitGrid &impenetrable, const Colliders &colliders)
+	{
+		hits.clear();
+		if (shots.empty()) {
+			return hits;
+		}
+
+		buildCells(ecs, impenetrable, colliders);
+
+		const auto isImpenetrable = [&impenetrable](int x, int y) {
+			return !impenetrable.isInBounds(x, y) || impenetrable.get(x, y);
+		};
+
+		constexpr float cellSize = CELL_SIZE * TILE_SIZE;
+		for (const HitscanShot &shot : shots) {
+			const Vec2f delta = shot.to - shot.from;
+			float maxFraction = LineOfSight::traceSegment(shot.from, shot.to, TILE_SIZE, isImpenetrable).value_or(1.0f);
+
+			std::optional<HitscanHit> nearest;
+			const Rectf point{shot.from.x, shot.from.y, 0, 0};
+			// never blocks, only visits every cell the shot crosses
+			LineOfSight::traceSegment(shot.from, shot.to, cellSize, [&](int x, int y) {
+				if (x < 0 || x >= cellsX || y < 0 || y >= cellsY) {
+					return false;
+				}
+
+				for (const CellEntry &entry : cells[y * cellsX + x]) {
+					if (entry.entity == shot.shooter) {
+						continue;
+					}
+
+					const std::optional<float> fraction = AABB::sweep(point, delta, entry.boundingBox);
+					if (fraction && *fraction <= maxFraction) {
+						maxFraction = *fraction;
+						nearest = HitscanHit{shot.shooter, entry.entity, shot.from + delta * *fraction, shot.damage};
+					}
+				}
+				return false;
+			});
+
+			if (nearest) {
+				hits.push_back(*nearest);
+			}
+		}
+
+		shots.clear();
+		return hits;
+	}
+
+  private:
+	struct CellEntry {
+		Easys::Entity entity;
+		Rectf boundingBox;
+	};
+
+	// Puts every collider into all cells its bounding box overlaps.
+	template <typename Colliders>
+	void buildCells(Easys::ECS &ecs, const BitGrid &impenetrable, const Colliders &colliders)
+	{
+		cellsX = (impenetrable.getWidth() + CELL_SIZE - 1) / CELL_SIZE;
+		cellsY = (impenetrable.getHeight() + CELL_SIZE - 1) / CELL_SIZE;
+		cells.resize(cellsX * cellsY);
+		for (std::vector<CellEntry> &cell : cells) {
+			cell.clear();
+		}
+
+		constexpr float cellSize = CELL_SIZE * TILE_SIZE;
+		for (const Easys::Entity &entity : colliders) {
+			const Vec2f position = ecs.getComponent<Positionable>(entity).position;
+			const Rectf boundingBox{position.x, position.y, TILE_SIZE, TILE_SIZE};
+
+			const int beginX = std::max(0, static_cast<int>(std::floor(boundingBox.x / cellSize)));
+			const int endX = std::min(cellsX - 1, static_cast<int>(std::floor((boundingBox.x + TILE_SIZE) / cellSize)));
+			const int beginY = std::max(0, static_cast<int>(std::floor(boundingBox.y / cellSize)));
+			const int endY = std::min(cellsY - 1, static_cast<int>(std::floor((boundingBox.y + TILE_SIZE) / cellSize)));
+			for (int y = beginY; y <= endY; y++) {
+				for (int x = beginX; x <= endX; x++) {
+					cells[y * cellsX + x].push_back({entity, boundingBox});
+				}
+			}
+		}
+	}
+
+	std::vector<HitscanShot> shots;
+	std::vector<HitscanHit> hits;
+
+	// scratch space, rebuilt by every resolve()
+	int cellsX = 0, cellsY = 0;
+	std::vector<std::vector<CellEntry>> cells;
+};
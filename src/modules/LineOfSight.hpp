@@ -0,0 +1,175 @@
+#pragma once
+
+#include "../engine/types/Vec2f.hpp"
+#include "../engine/types/Vec2i.hpp"
+#include "../map/BitGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <vector>
+
+// Line of sight queries on a grid of blocking tiles (see MapManager::getObstacleGrid()).
+//
+// The traversal walks the supercover line between two tile centers with integer arithmetic only, so it needs no
+// divisions (axis aligned rays are fine) and does not allocate. Every tile the line touches is visited. If the line
+// passes exactly through a corner, it is only blocked if both tiles next to the corner block.
+//
+// The tiles at both ends are not tested: an observer standing next to a wall can still see it, and a target is not
+// hidden by the tile it stands on.
+//
+// traceSegment() is the same walk for arbitrary segments in pixel space, e.g. a projectile's movement during a frame.
+class LineOfSight {
+  public:
+	static constexpr int NO_RANGE_LIMIT = -1;
+
+	// from and to are in tile space. maxRange is in tiles and compared against the euclidean distance.
+	static bool isVisible(const BitGrid &grid, const Vec2i &from, const Vec2i &to, int maxRange = NO_RANGE_LIMIT)
+	{
+		if (!grid.isInBounds(from) || !grid.isInBounds(to) || !isInRange(from, to, maxRange)) {
+			return false;
+		}
+
+		return trace(from, to, [&grid](int x, int y) { return grid.get(x, y); });
+	}
+
+	// One origin, many targets. Writes 1 (visible) or 0 (not visible) to result for each target.
+	static void isVisibleBatch(const BitGrid &grid, const Vec2i &origin, const Vec2i *targets, std::size_t count,
+	                           std::uint8_t *result, int maxRange = NO_RANGE_LIMIT)
+	{
+		if (!grid.isInBounds(origin)) {
+			std::fill(result, result + count, std::uint8_t{0});
+			return;
+		}
+
+		const auto isBlocked = [&grid](int x, int y) { return grid.get(x, y); };
+		for (std::size_t i = 0; i < count; i++) {
+			const Vec2i &target = targets[i];
+			result[i] = grid.isInBounds(target) && isInRange(origin, target, maxRange) && trace(origin, target, isBlocked);
+		}
+	}
+
+	static void isVisibleBatch(const BitGrid &grid, const Vec2i &origin, const std::vector<Vec2i> &targets,
+	                           std::vector<std::uint8_t> &result, int maxRange = NO_RANGE_LIMIT)
+	{
+		result.resize(targets.size());
+		isVisibleBatch(grid, origin, targets.data(), targets.size(), result.data(), maxRange);
+	}
+
+	// Walks from `from` to `to` and returns false as soon as isBlocked(x, y) returns true for a tile in between.
+	// Callers are responsible for bounds checks; all visited tiles lie within the rectangle spanned by from and to.
+	template <typename IsBlocked>
+	static bool trace(const Vec2i &from, const Vec2i &to, IsBlocked &&isBlocked)
+	{
+		const int dx = std::abs(to.x - from.x);
+		const int dy = std::abs(to.y - from.y);
+		const int stepX = (to.x > from.x) ? 1 : -1;
+		const int stepY = (to.y > from.y) ? 1 : -1;
+
+		// error tracks on which side of the line the next tile corner lies (scaled by 2 to stay in integers)
+		int error = dx - dy;
+		int remaining = dx + dy;
+		int x = from.x;
+		int y = from.y;
+
+		while (remaining > 0) {
+			if (error > 0) {
+				x += stepX;
+				error -= 2 * dy;
+				remaining -= 1;
+			} else if (error < 0) {
+				y += stepY;
+				error += 2 * dx;
+				remaining -= 1;
+			} else {
+				// exactly through a corner
+				if (isBlocked(x + stepX, y) && isBlocked(x, y + stepY)) {
+					return false;
+				}
+				x += stepX;
+				y += stepY;
+				error += 2 * (dx - dy);
+				remaining -= 2;
+			}
+
+			if (remaining == 0) {
+				break; // reached the target tile
+			}
+
+			if (isBlocked(x, y)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Walks the tiles touched by the segment from `from` to `to` (in pixels) in order, starting with the tile of
+	// `from`. Returns the fraction of the segment (0 to 1) at which it enters the first tile for which isBlocked(x, y)
+	// returns true, or nothing if there is none. isBlocked has to handle tiles outside of the map.
+	template <typename IsBlocked>
+	static std::optional<float> traceSegment(const Vec2f &from, const Vec2f &to, float tileSize, IsBlocked &&isBlocked)
+	{
+		int x = static_cast<int>(std::floor(from.x / tileSize));
+		int y = static_cast<int>(std::floor(from.y / tileSize));
+		if (isBlocked(x, y)) {
+			return 0.0f;
+		}
+
+		const int endX = static_cast<int>(std::floor(to.x / tileSize));
+		const int endY = static_cast<int>(std::floor(to.y / tileSize));
+		const float dx = to.x - from.x;
+		const float dy = to.y - from.y;
+		const int stepX = dx > 0 ? 1 : -1;
+		const int stepY = dy > 0 ? 1 : -1;
+
+		// fraction of the segment needed to cross a whole tile and to reach the next tile border, per axis
+		constexpr float never = std::numeric_limits<float>::infinity();
+		const float crossX = dx != 0 ? tileSize / std::fabs(dx) : never;
+		const float crossY = dy != 0 ? tileSize / std::fabs(dy) : never;
+		float nextX = never;
+		if (dx != 0)
+			nextX = (stepX > 0 ? (x + 1) * tileSize - from.x : from.x - x * tileSize) / std::fabs(dx);
+		float nextY = never;
+		if (dy != 0)
+			nextY = (stepY > 0 ? (y + 1) * tileSize - from.y : from.y - y * tileSize) / std::fabs(dy);
+
+		while (x != endX || y != endY) {
+			float fraction;
+			if (nextX < nextY) {
+				x += stepX;
+				fraction = nextX;
+				nextX += crossX;
+			} else {
+				y += stepY;
+				fraction = nextY;
+				nextY += crossY;
+			}
+
+			if (fraction > 1.0f) {
+				break; // rounding errors, the segment ended before reaching this tile
+			}
+
+			if (isBlocked(x, y)) {
+				return fraction;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+  private:
+	static bool isInRange(const Vec2i &from, const Vec2i &to, int maxRange)
+	{
+		if (maxRange == NO_RANGE_LIMIT) {
+			return true;
+		}
+
+		const int dx = to.x - from.x;
+		const int dy = to.y - from.y;
+		return dx * dx + dy * dy <= maxRange * maxRange;
+	}
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../engine/types/Vec2f.hpp"
+#include "../items/WeaponMetadata.hpp"
+#include <cstddef>
+#include <easys/easys.hpp>
+#include <vector>
+
+// All projectiles in flight, stored as a structure of arrays outside of the ECS.
+//
+// Projectiles only live for a fraction of a second, but automatic weapons fire many of them. Making them entities
+// means several component insertions and removals per shot, and updating them means looking up components for each
+// one. Here spawning appends to the arrays and removing moves the last projectile into the gap, so the arrays always
+// stay dense and the ProjectileSystem can update them with plain loops over contiguous floats.
+//
+// Indices are not stable, removing a projectile moves another one. Shooters are still referenced by entity.
+struct ProjectilePool {
+	std::vector<float> x, y;                 // top left corner, in pixels
+	std::vector<float> velocityX, velocityY; // in pixels per second
+	std::vector<float> startX, startY;       // where the projectile was fired
+	std::vector<float> range;                // in pixels, measured from the start position
+	std::vector<int> damage;
+	std::vector<Easys::Entity> shooter; // entity id of the entity that shot the weapon
+	std::vector<WeaponID> weapon;       // weapon id of the weapon that was shot
+
+	void spawn(const Vec2f &start, const Vec2f &velocity, float maxRange, int amount, Easys::Entity shooterEntity,
+	           WeaponID weaponId)
+	{
+		x.push_back(start.x);
+		y.push_back(start.y);
+		velocityX.push_back(velocity.x);
+		velocityY.push_back(velocity.y);
+		startX.push_back(start.x);
+		startY.push_back(start.y);
+		range.push_back(maxRange);
+		damage.push_back(amount);
+		shooter.push_back(shooterEntity);
+		weapon.push_back(weaponId);
+	}
+
+	// Moves the last projectile to index. Removing while iterating backwards does not skip any projectile.
+	void remove(const std::size_t index)
+	{
+		removeAt(x, index);
+		removeAt(y, index);
+		removeAt(velocityX, index);
+		removeAt(velocityY, index);
+		removeAt(startX, index);
+		removeAt(startY, index);
+		removeAt(range, index);
+		removeAt(damage, index);
+		removeAt(shooter, index);
+		removeAt(weapon, index);
+	}
+
+	void clear()
+	{
+		x.clear();
+		y.clear();
+		velocityX.clear();
+		velocityY.clear();
+		startX.clear();
+		startY.clear();
+		range.clear();
+		damage.clear();
+		shooter.clear();
+		weapon.clear();
+	}
+
+	std::size_t size() const { return x.size(); }
+	bool empty() const { return x.empty(); }
+
+	Vec2f getPosition(const std::size_t index) const { return {x[index], y[index]}; }
+
+  private:
+	template <typename T>
+	static void removeAt(std::vector<T> &values, const std::size_t index)
+	{
+		values[index] = values.back();
+		values.pop_back();
+	}
+};
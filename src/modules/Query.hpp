@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <easys/easys.hpp>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+class QueryBase {
+  public:
+	virtual ~QueryBase() = default;
+
+	// Re-evaluates whether entity (still) matches the query.
+	virtual void update(Easys::Entity entity) = 0;
+	virtual void rebuild() = 0;
+};
+
+// A cached list of all entities which have every component in Ts.
+//
+// Systems iterate this dense list instead of walking the whole entity set and calling hasComponent for every entity.
+// The list is sorted by entity like Easys::ECS::getEntities, so systems see entities in the same order as before. It is
+// kept up to date by the QueryRegistry, which has to be told about structural changes (see CommandBuffer).
+template <typename... Ts>
+class Query final : public QueryBase {
+  public:
+	explicit Query(Easys::ECS &ecs) : ecs_(ecs) { rebuild(); }
+
+	void update(const Easys::Entity entity) override
+	{
+		auto it = std::lower_bound(entities.begin(), entities.end(), entity);
+		const bool isContained = it != entities.end() && *it == entity;
+
+		if (matches(entity)) {
+			if (!isContained)
+				entities.insert(it, entity);
+		} else if (isContained) {
+			entities.erase(it);
+		}
+	}
+
+	void rebuild() override
+	{
+		entities.clear();
+		for (const Easys::Entity &entity : ecs_.getEntities()) {
+			if (matches(entity)) {
+				entities.push_back(entity);
+			}
+		}
+	}
+
+	// Calls f(entity, components...) with references to the components in the order of Ts.
+	template <typename Function>
+	void forEach(Function &&f)
+	{
+		for (const Easys::Entity entity : entities) {
+			f(entity, ecs_.getComponent<Ts>(entity)...);
+		}
+	}
+
+	bool contains(const Easys::Entity entity) const
+	{
+		return std::binary_search(entities.begin(), entities.end(), entity);
+	}
+
+	std::vector<Easys::Entity>::const_iterator begin() const { return entities.begin(); }
+	std::vector<Easys::Entity>::const_iterator end() const { return entities.end(); }
+	std::size_t size() const { return entities.size(); }
+	bool isEmpty() const { return entities.empty(); }
+
+  private:
+	bool matches(const Easys::Entity entity) const
+	{
+		return ecs_.hasEntity(entity) && (ecs_.hasComponent<Ts>(entity) && ...);
+	}
+
+	Easys::ECS &ecs_;
+	std::vector<Easys::Entity> entities;
+};
+
+// Owns every Query of the game. Queries are created on first use and shared by everyone asking for the same
+// components.
+//
+// Structural changes have to be reported here: CommandBuffer::playback reports the entities it touched, and everything
+// replacing the whole ECS (loading a save, spawning the level) calls rebuild. Components which are added or removed
+// directly only stay consistent if no query uses them.
+class QueryRegistry {
+  public:
+	explicit QueryRegistry(Easys::ECS &ecs) : ecs_(ecs) {}
+
+	template <typename... Ts>
+	Query<Ts...> &get()
+	{
+		std::unique_ptr<QueryBase> &query = queries[std::type_index(typeid(Query<Ts...>))];
+		if (!query) {
+			query = std::make_unique<Query<Ts...>>(ecs_);
+		}
+		return static_cast<Query<Ts...> &>(*query);
+	}
+
+	void update(const Easys::Entity entity)
+	{
+		for (auto &[type, query] : queries) {
+			query->update(entity);
+		}
+	}
+
+	void rebuild()
+	{
+		for (auto &[type, query] : queries) {
+			query->rebuild();
+		}
+	}
+
+  private:
+	Easys::ECS &ecs_;
+	std::unordered_map<std::type_index, std::unique_ptr<QueryBase>> queries;
+};
@@ -11,10 +11,12 @@
 #include "../components/Renderable.hpp"
 #include "../components/RigidBody.hpp"
 #include "../components/Rotatable.hpp"
-#include "../components/SoundEmitter.hpp"
 #include "../components/Stats.hpp"
-#include "../components/Tombstone.hpp"
 #include "../constants.hpp"
+#include "EntityHandle.hpp"
+#include "Events.hpp"
+#include "ProjectilePool.hpp"
+#include "Query.hpp"
 #include <cereal/archives/json.hpp>
 #include <cereal/types/queue.hpp>
 #include <cereal/types/set.hpp>
@@ -34,6 +36,14 @@ class SaveGameManager {
 	{
 	}
 
+	// Queries are rebuilt and handles invalidated after loading, since loading replaces every entity. Projectiles and
+	// pending events are dropped, they refer to entities of the replaced world.
+	SaveGameManager(Easys::ECS &ecs, QueryRegistry &queries, EntityGenerations &generations,
+	                ProjectilePool &projectiles, Events &events)
+	    : ecs_(ecs), queries_(&queries), generations_(&generations), projectiles_(&projectiles), events_(&events)
+	{
+	}
+
 	void save(const std::string path)
 	{
 		std::cout << "saving to " << path << std::endl;
@@ -78,6 +88,19 @@ class SaveGameManager {
 			using T = decltype(dummy);
 			deserializeComponentsByType<T>(archive);
 		});
+
+		if (queries_) {
+			queries_->rebuild();
+		}
+		if (generations_) {
+			generations_->invalidateAll();
+		}
+		if (projectiles_) {
+			projectiles_->clear();
+		}
+		if (events_) {
+			events_->clear();
+		}
 	}
 
   private:
@@ -118,4 +141,8 @@ class SaveGameManager {
 	}
 
 	Easys::ECS &ecs_;
+	QueryRegistry *queries_ = nullptr;
+	EntityGenerations *generations_ = nullptr;
+	ProjectilePool *projectiles_ = nullptr;
+	Events *events_ = nullptr;
 };
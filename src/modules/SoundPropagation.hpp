@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../engine/types/Vec2i.hpp"
+#include "../map/BitGrid.hpp"
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Propagates sounds over the map. The distance a sound travelled is the cheapest path from its source tile, where
+// every step onto an open tile costs 1 and every step onto a blocking tile costs WALL_DAMPENING. So sounds travel
+// around walls and are muffled when passing through them.
+//
+// Distance fields are computed with Dijkstra up to maxRange and cached per source tile. Repeated noises from the same
+// tile (e.g. full-auto fire) reuse the cached field, so a lookup is a single array access. The least recently used
+// field is evicted once MAX_CACHED_FIELDS is reached.
+class SoundPropagation {
+  public:
+	static constexpr int WALL_DAMPENING = 6;
+	static constexpr std::size_t MAX_CACHED_FIELDS = 64;
+	static constexpr std::uint16_t UNREACHABLE = UINT16_MAX;
+
+	// maxRange is in tiles and should be the loudest noise in the game.
+	explicit SoundPropagation(int maxRange) : maxRange_(maxRange) {}
+
+	// Returns the distance from source to target or UNREACHABLE if it is further than maxRange.
+	int getDistance(const BitGrid &obstacles, const Vec2i &source, const Vec2i &target)
+	{
+		if (!obstacles.isInBounds(source) || !obstacles.isInBounds(target)) {
+			return UNREACHABLE;
+		}
+
+		return getDistanceField(obstacles, source)[target.y * obstacles.getWidth() + target.x];
+	}
+
+	// Row major distances from source to every tile of the map.
+	const std::vector<std::uint16_t> &getDistanceField(const BitGrid &obstacles, const Vec2i &source)
+	{
+		const int key = source.y * obstacles.getWidth() + source.x;
+		auto it = cache.find(key);
+		if (it == cache.end()) {
+			if (cache.size() >= MAX_CACHED_FIELDS) {
+				evictLeastRecentlyUsed();
+			}
+			it = cache.emplace(key, CachedField{}).first;
+			propagate(obstacles, source, it->second.distances);
+		}
+
+		it->second.lastUsed = ++clock;
+		return it->second.distances;
+	}
+
+	// Needs to be called whenever the obstacles change, e.g. when a new map is loaded.
+	void clear() { cache.clear(); }
+
+	std::size_t getCacheSize() const { return cache.size(); }
+
+  private:
+	struct CachedField {
+		std::vector<std::uint16_t> distances;
+		std::uint64_t lastUsed = 0;
+	};
+
+	void propagate(const BitGrid &obstacles, const Vec2i &source, std::vector<std::uint16_t> &distances) const
+	{
+		const int width = obstacles.getWidth();
+		distances.assign(width * obstacles.getHeight(), UNREACHABLE);
+
+		using Entry = std::pair<int, int>; // distance, tile index
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		distances[source.y * width + source.x] = 0;
+		queue.push({0, source.y * width + source.x});
+
+		constexpr Vec2i directions[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+		while (!queue.empty()) {
+			const auto [distance, index] = queue.top();
+			queue.pop();
+			if (distance > distances[index]) {
+				continue; // outdated entry
+			}
+
+			const Vec2i tile{index % width, index / width};
+			for (const Vec2i &direction : directions) {
+				const Vec2i neighbour = tile + direction;
+				if (!obstacles.isInBounds(neighbour)) {
+					continue;
+				}
+
+				const int next = distance + (obstacles.get(neighbour) ? WALL_DAMPENING : 1);
+				const int neighbourIndex = neighbour.y * width + neighbour.x;
+				if (next <= maxRange_ && next < distances[neighbourIndex]) {
+					distances[neighbourIndex] = static_cast<std::uint16_t>(next);
+					queue.push({next, neighbourIndex});
+				}
+			}
+		}
+	}
+
+	void evictLeastRecentlyUsed()
+	{
+		auto oldest = cache.begin();
+		for (auto it = cache.begin(); it != cache.end(); ++it) {
+			if (it->second.lastUsed < oldest->second.lastUsed) {
+				oldest = it;
+			}
+		}
+		cache.erase(oldest);
+	}
+
+	int maxRange_;
+	std::uint64_t clock = 0;
+	std::unordered_map<int, CachedField> cache;
+};
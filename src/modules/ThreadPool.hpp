@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads for splitting a loop over all cores.
+//
+// The threads are started once and sleep between jobs, so a job only costs a wake-up instead of a thread creation.
+// The calling thread works on the job as well and has thread index 0, the workers have 1 to getThreadCount() - 1.
+class ThreadPool {
+  public:
+	static constexpr std::size_t BATCH_SIZE = 4; // indices a thread takes at once
+
+	explicit ThreadPool(std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency()))
+	{
+		for (std::size_t threadIndex = 1; threadIndex < threadCount; threadIndex++) {
+			workers.emplace_back([this, threadIndex] { work(threadIndex); });
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wakeUp.notify_all();
+		for (std::thread &worker : workers) {
+			worker.join();
+		}
+	}
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	std::size_t getThreadCount() const { return workers.size() + 1; }
+
+	// Calls task(index, threadIndex) for every index in [0, count) and returns once all calls are done. Calls with the
+	// same threadIndex never overlap, so it can be used to pick per-thread buffers. The task must not throw.
+	template <typename Task>
+	void parallelFor(const std::size_t count, Task &&task)
+	{
+		if (workers.empty() || count <= BATCH_SIZE) {
+			for (std::size_t index = 0; index < count; index++) {
+				task(index, std::size_t{0});
+			}
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = [&task](std::size_t index, std::size_t threadIndex) { task(index, threadIndex); };
+			jobSize = count;
+			nextIndex = 0;
+			finishedWorkers = 0;
+			generation++;
+		}
+		wakeUp.notify_all();
+
+		runJob(0);
+
+		// Wait for every worker, even the ones which found no work left, so none of them still uses the job.
+		std::unique_lock<std::mutex> lock(mutex);
+		jobDone.wait(lock, [this] { return finishedWorkers == workers.size(); });
+		job = nullptr;
+	}
+
+  private:
+	void work(const std::size_t threadIndex)
+	{
+		std::uint64_t seenGeneration = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeUp.wait(lock, [&] { return stopping || generation != seenGeneration; });
+				if (stopping) {
+					return;
+				}
+				seenGeneration = generation;
+			}
+
+			runJob(threadIndex);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				finishedWorkers++;
+			}
+			jobDone.notify_one();
+		}
+	}
+
+	void runJob(const std::size_t threadIndex)
+	{
+		while (true) {
+			const std::size_t begin = nextIndex.fetch_add(BATCH_SIZE);
+			if (begin >= jobSize) {
+				return;
+			}
+			const std::size_t end = std::min(begin + BATCH_SIZE, jobSize);
+			for (std::size_t index = begin; index < end; index++) {
+				job(index, threadIndex);
+			}
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::condition_variable jobDone;
+
+	std::function<void(std::size_t, std::size_t)> job;
+	std::size_t jobSize = 0;
+	std::atomic<std::size_t> nextIndex = 0;
+	std::size_t finishedWorkers = 0;
+	std::uint64_t generation = 0;
+	bool stopping = false;
+};
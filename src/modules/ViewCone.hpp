@@ -0,0 +1,136 @@
+#pragma once
+
+#include "../engine/types/Vec2f.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VIEWCONE_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VIEWCONE_SSE2
+#endif
+
+// Everything the per-candidate test needs, precomputed once per observer.
+//
+// A target at offset d is inside the cone, if |d|^2 <= range^2 and dot(forward, d) >= cos(halfAngle) * |d|.
+// Squaring both sides of the angle test while keeping their signs (x -> x * |x| is monotonic) gives
+// dot * |dot| >= cos * |cos| * |d|^2, which needs neither a sqrt nor an acos and works for cones wider than 180 degrees.
+struct ViewConeParams {
+	Vec2f origin;               // in pixel space
+	Vec2f forward;              // normalised facing direction
+	float rangeSquared;         // in pixels
+	float cosHalfAngleSquared;  // cos(halfAngle) * |cos(halfAngle)|
+};
+
+// Candidate positions as a structure of arrays, so the batched test can load several x and y values at once.
+struct ViewConeCandidates {
+	std::vector<float> x;
+	std::vector<float> y;
+
+	void clear()
+	{
+		x.clear();
+		y.clear();
+	}
+
+	void push_back(const Vec2f &position)
+	{
+		x.push_back(position.x);
+		y.push_back(position.y);
+	}
+
+	std::size_t size() const { return x.size(); }
+};
+
+class ViewCone {
+  public:
+	// range in pixels, angle is the full field of view in degrees (see Vision component).
+	static ViewConeParams makeParams(const Vec2f &origin, const Vec2f &forward, float range, float angle)
+	{
+		const float cosHalfAngle = std::cos((angle / 2.0f) * (static_cast<float>(M_PI) / 180.0f));
+		return {origin, forward.norm(), range * range, cosHalfAngle * std::fabs(cosHalfAngle)};
+	}
+
+	static bool isInside(const ViewConeParams &cone, const Vec2f &target)
+	{
+		const float dx = target.x - cone.origin.x;
+		const float dy = target.y - cone.origin.y;
+		const float distanceSquared = dx * dx + dy * dy;
+		const float dot = dx * cone.forward.x + dy * cone.forward.y;
+
+		return distanceSquared <= cone.rangeSquared && dot * std::fabs(dot) >= cone.cosHalfAngleSquared * distanceSquared;
+	}
+
+	// Tests count candidates against the cone and writes 1 (inside) or 0 (outside) to mask for each of them.
+	// mask needs room for count entries.
+	static void testBatch(const ViewConeParams &cone, const float *xs, const float *ys, std::size_t count,
+	                      std::uint8_t *mask)
+	{
+		std::size_t i = 0;
+
+#if defined(VIEWCONE_AVX)
+		const __m256 ox = _mm256_set1_ps(cone.origin.x);
+		const __m256 oy = _mm256_set1_ps(cone.origin.y);
+		const __m256 fx = _mm256_set1_ps(cone.forward.x);
+		const __m256 fy = _mm256_set1_ps(cone.forward.y);
+		const __m256 range = _mm256_set1_ps(cone.rangeSquared);
+		const __m256 cosine = _mm256_set1_ps(cone.cosHalfAngleSquared);
+		const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+
+		for (; i + 8 <= count; i += 8) {
+			const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), ox);
+			const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), oy);
+			const __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+			const __m256 dot = _mm256_add_ps(_mm256_mul_ps(dx, fx), _mm256_mul_ps(dy, fy));
+			const __m256 lhs = _mm256_mul_ps(dot, _mm256_and_ps(dot, absMask));
+			const __m256 rhs = _mm256_mul_ps(cosine, distanceSquared);
+			const __m256 inside = _mm256_and_ps(_mm256_cmp_ps(distanceSquared, range, _CMP_LE_OQ),
+			                                    _mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ));
+			writeMask(_mm256_movemask_ps(inside), 8, mask + i);
+		}
+#elif defined(VIEWCONE_SSE2)
+		const __m128 ox = _mm_set1_ps(cone.origin.x);
+		const __m128 oy = _mm_set1_ps(cone.origin.y);
+		const __m128 fx = _mm_set1_ps(cone.forward.x);
+		const __m128 fy = _mm_set1_ps(cone.forward.y);
+		const __m128 range = _mm_set1_ps(cone.rangeSquared);
+		const __m128 cosine = _mm_set1_ps(cone.cosHalfAngleSquared);
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+		for (; i + 4 <= count; i += 4) {
+			const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), ox);
+			const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), oy);
+			const __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			const __m128 dot = _mm_add_ps(_mm_mul_ps(dx, fx), _mm_mul_ps(dy, fy));
+			const __m128 lhs = _mm_mul_ps(dot, _mm_and_ps(dot, absMask));
+			const __m128 rhs = _mm_mul_ps(cosine, distanceSquared);
+			const __m128 inside = _mm_and_ps(_mm_cmple_ps(distanceSquared, range), _mm_cmpge_ps(lhs, rhs));
+			writeMask(_mm_movemask_ps(inside), 4, mask + i);
+		}
+#endif
+
+		// scalar fallback, also handles the remainder of the vectorised loops
+		for (; i < count; i++) {
+			mask[i] = isInside(cone, Vec2f{xs[i], ys[i]}) ? 1 : 0;
+		}
+	}
+
+	static void testBatch(const ViewConeParams &cone, const ViewConeCandidates &candidates,
+	                      std::vector<std::uint8_t> &mask)
+	{
+		mask.resize(candidates.size());
+		testBatch(cone, candidates.x.data(), candidates.y.data(), candidates.size(), mask.data());
+	}
+
+  private:
+	static void writeMask(int bits, int lanes, std::uint8_t *mask)
+	{
+		for (int lane = 0; lane < lanes; lane++) {
+			mask[lane] = static_cast<std::uint8_t>((bits >> lane) & 1);
+		}
+	}
+};
@@ -1,87 +1,217 @@
 #pragma once
 
 #include "../components/AI.hpp"
+#include "../components/Hearing.hpp"
 #include "../components/Positionable.hpp"
 #include "../components/Rotatable.hpp"
 #include "../components/Vision.hpp"
 #include "../engine/types/Vec2i.hpp"
 #include "../map/MapManager.hpp"
 #include "../map/TileRegistry.hpp" // TileMetadata struct
-#include "../modules/DDA.hpp"
+#include "../modules/Events.hpp"
+#include "../modules/SoundPropagation.hpp"
 #include "../modules/Utils.hpp"
+#include "../modules/ViewCone.hpp"
 #include "../systems/System.hpp"
 #include <cmath>
+#include <cstdint>
 #include <easys/easys.hpp>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 // This system is a subsystem of AISystem. This means it is contained and run within the AISystem class.
 class AIPerceptionSystem : public System {
   public:
-	AIPerceptionSystem(const MapManager &mapManager) : mapManager_(mapManager)
+	AIPerceptionSystem(const MapManager &mapManager, const Events &events)
+	    : mapManager_(mapManager), events_(events), soundPropagation(SOUND_PROPAGATION_RANGE)
 	{
-		visionMap = mapManager.getWalkableMapView();
 	}
 
 	void update(Easys::ECS &ecs, const double deltaTime)
 	{
+		gatherCandidates(ecs);
+		gatherNoises();
+
+		if (mapManager_.getObstacleVersion() != soundObstacleVersion) {
+			soundPropagation.clear(); // the cached distance fields depend on the obstacles
+			soundObstacleVersion = mapManager_.getObstacleVersion();
+		}
+
 		for (const Easys::Entity &entity : ecs.getEntities()) {
 			if (ecs.hasComponent<Vision>(entity)) {
 				const auto &pos = ecs.getComponent<Positionable>(entity).position;
 				const auto &rot = ecs.getComponent<Rotatable>(entity).rotation;
 				auto &vision = ecs.getComponent<Vision>(entity);
 
-				vision.visibleEnemies.clear();
-				vision.visibleAllies.clear();
-
 				// update vision
-				for (const Easys::Entity &otherEntity : ecs.getEntities()) { // AI currently only needs to see the player
-					if (entity == otherEntity)
-						continue;
-
-					const auto &otherPos = ecs.getComponent<Positionable>(otherEntity).position;
-
-					if (isWithinViewCone(pos, otherPos, rot, (float)vision.range, (float)vision.angle)) {
-						// Perform obstacle check
-						bool didCollide = DDA::castRay(visionMap, Utils::toTileSize(pos), Utils::toTileSize(otherPos));
-						if (!didCollide) {
-							if (ecs.hasComponent<Controllable>(otherEntity))
-								vision.visibleEnemies.push_back(otherEntity);
-							else
-								vision.visibleAllies.push_back(otherEntity);
-						}
-					}
+				const Vec2f forward = Utils::rotationToVec2f(rot);
+				const VisionKey key{pos, forward, vision.range, vision.angle, mapManager_.getObstacleVersion()};
+				if (key.obstacleVersion != vision.perceivedFor.obstacleVersion) {
+					vision.fieldOfView.invalidate();
+				}
+				updateFieldOfView(vision, Utils::toTileSize(pos), forward);
+
+				const ViewConeParams cone = ViewCone::makeParams(pos, forward, vision.range, vision.angle);
+				if (key == vision.perceivedFor) {
+					updateMovedCandidates(ecs, entity, vision, cone);
+				} else {
+					updateAllCandidates(ecs, entity, vision, cone);
+					vision.perceivedFor = key;
 				}
 			}
 
 			// update hearing
+			if (ecs.hasComponent<Hearing>(entity) && ecs.hasComponent<Positionable>(entity)) {
+				updateHearing(ecs, entity);
+			}
 
 			// update other sensory inputs (danger)
 		}
 	}
 
   private:
-	// Function to calculate whether an entity is within the view cone
-	bool isWithinViewCone(const Vec2f &sourcePos, const Vec2f &targetPos, Rotation rotation, float visionRange,
-	                      float visionAngle) const
+	void updateAllCandidates(Easys::ECS &ecs, const Easys::Entity entity, Vision &vision, const ViewConeParams &cone)
 	{
-		Vec2f forwardDirection = Utils::rotationToVec2f(rotation);
-		Vec2f toEntity = {(float)(targetPos.x - sourcePos.x), (float)(targetPos.y - sourcePos.y)};
-		const float distance = toEntity.length();
+		vision.visibleEnemies.clear();
+		vision.visibleAllies.clear();
 
-		if (distance > visionRange)
-			return false;
+		ViewCone::testBatch(cone, candidates, candidateMask);
 
-		forwardDirection = forwardDirection.norm();
-		toEntity = toEntity.norm();
+		for (std::size_t i = 0; i < candidateEntities.size(); i++) {
+			if (!candidateMask[i] || entity == candidateEntities[i])
+				continue;
 
-		// Calculate angle using dot product
-		float dotProduct = forwardDirection.x * toEntity.x + forwardDirection.y * toEntity.y;
-		float angleToEntity = std::acos(dotProduct) * (180.0f / (float)M_PI); // Convert to degrees
+			// obstacle check
+			if (!vision.fieldOfView.isVisible(Utils::toTileSize(Vec2f{candidates.x[i], candidates.y[i]})))
+				continue;
 
-		// Check if within vision angle
-		return angleToEntity <= (visionAngle / 2);
+			addVisible(ecs, vision, candidateEntities[i]);
+		}
+	}
+
+	// The observer did not move since its last update, so only the candidates which moved need to be tested again. The
+	// others keep their result from the last update. Both the visible lists and the candidates are sorted by entity.
+	void updateMovedCandidates(Easys::ECS &ecs, const Easys::Entity entity, Vision &vision, const ViewConeParams &cone)
+	{
+		previousEnemies.swap(vision.visibleEnemies);
+		previousAllies.swap(vision.visibleAllies);
+		vision.visibleEnemies.clear();
+		vision.visibleAllies.clear();
+
+		auto enemy = previousEnemies.begin();
+		auto ally = previousAllies.begin();
+		for (std::size_t i = 0; i < candidateEntities.size(); i++) {
+			const Easys::Entity other = candidateEntities[i];
+			while (enemy != previousEnemies.end() && *enemy < other)
+				++enemy;
+			while (ally != previousAllies.end() && *ally < other)
+				++ally;
+
+			if (entity == other)
+				continue;
+
+			if (!candidateMoved[i]) {
+				if (enemy != previousEnemies.end() && *enemy == other)
+					vision.visibleEnemies.push_back(other);
+				else if (ally != previousAllies.end() && *ally == other)
+					vision.visibleAllies.push_back(other);
+				continue;
+			}
+
+			const Vec2f position{candidates.x[i], candidates.y[i]};
+			if (ViewCone::isInside(cone, position) && vision.fieldOfView.isVisible(Utils::toTileSize(position)))
+				addVisible(ecs, vision, other);
+		}
+	}
+
+	void addVisible(Easys::ECS &ecs, Vision &vision, const Easys::Entity other) const
+	{
+		if (ecs.hasComponent<Controllable>(other))
+			vision.visibleEnemies.push_back(other);
+		else
+			vision.visibleAllies.push_back(other);
+	}
+
+	// The field of view only depends on the tile and the rotation, so guards standing still do not recompute it.
+	void updateFieldOfView(Vision &vision, const Vec2i &tile, const Vec2f &forward)
+	{
+		const int radius = static_cast<int>(vision.range) / TILE_SIZE;
+		if (!vision.fieldOfView.isComputedFor(tile, radius, forward, vision.angle)) {
+			vision.fieldOfView.compute(mapManager_.getObstacleGrid(), tile, radius, forward, vision.angle);
+		}
+	}
+
+	// Noises are propagated over the map with cached distance fields, so hearing a noise is a single lookup.
+	void updateHearing(Easys::ECS &ecs, const Easys::Entity &entity)
+	{
+		auto &hearing = ecs.getComponent<Hearing>(entity);
+		const Vec2i tile = Utils::toTileSize(ecs.getComponent<Positionable>(entity).position);
+		hearing.heardSounds.clear();
+
+		for (const SoundSource &noise : noises) {
+			if (noise.source == entity)
+				continue;
+
+			const int distance = soundPropagation.getDistance(mapManager_.getObstacleGrid(), noise.position, tile);
+			if (distance < noise.intensity && distance <= hearing.hearingRange) {
+				hearing.heardSounds.push_back({noise.source, noise.position, noise.type, noise.intensity - distance});
+			}
+		}
+	}
+
+	// Collects the sounds published since the last update.
+	void gatherNoises()
+	{
+		noises.clear();
+
+		for (const SoundEvent &sound : events_.sounds) {
+			noises.push_back({sound.entity, Utils::toTileSize(sound.position), sound.type, sound.loudness});
+		}
+	}
+
+	// Collects the positions of everything that can be seen once per frame, so every observer can run the batched view
+	// cone test over the same arrays. Candidates which are new or moved since the last frame are marked in
+	// candidateMoved.
+	void gatherCandidates(Easys::ECS &ecs)
+	{
+		std::swap(candidates, previousCandidates);
+		std::swap(candidateEntities, previousCandidateEntities);
+		candidates.clear();
+		candidateEntities.clear();
+		candidateMoved.clear();
+
+		std::size_t previous = 0;
+		for (const Easys::Entity &entity : ecs.getEntities()) {
+			if (ecs.hasComponent<Positionable>(entity)) {
+				const Vec2f &position = ecs.getComponent<Positionable>(entity).position;
+				while (previous < previousCandidateEntities.size() && previousCandidateEntities[previous] < entity)
+					previous++;
+
+				const bool isUnchanged = previous < previousCandidateEntities.size() &&
+				                         previousCandidateEntities[previous] == entity &&
+				                         previousCandidates.x[previous] == position.x &&
+				                         previousCandidates.y[previous] == position.y;
+				candidates.push_back(position);
+				candidateEntities.push_back(entity);
+				candidateMoved.push_back(isUnchanged ? 0 : 1);
+			}
+		}
 	}
 
 	const MapManager &mapManager_;
-	std::vector<std::vector<int>> visionMap;
+	const Events &events_;
+	SoundPropagation soundPropagation;
+	std::uint64_t soundObstacleVersion = 0;
+
+	// reused every frame to avoid reallocations
+	ViewConeCandidates candidates;
+	std::vector<Easys::Entity> candidateEntities;
+	std::vector<std::uint8_t> candidateMask;
+	std::vector<std::uint8_t> candidateMoved;
+	ViewConeCandidates previousCandidates;
+	std::vector<Easys::Entity> previousCandidateEntities;
+	std::vector<Easys::Entity> previousEnemies;
+	std::vector<Easys::Entity> previousAllies;
+	std::vector<SoundSource> noises; // intensity holds the loudness at the source
 };
\ No newline at end of file
@@ -1,48 +1,75 @@
 #pragma once
 
+#include "../ai/AICommands.hpp"
+#include "../ai/AIScheduler.hpp"
 #include "../ai/AIState.hpp"
+#include "../ai/InfluenceMap.hpp"
 #include "../components/AI.hpp"
+#include "../components/Pathfinding.hpp"
 #include "../components/Vision.hpp"
 #include "../engine/types/Vec2f.hpp"
 #include "../map/MapManager.hpp"
 #include "../modules/BTManager.hpp"
+#include "../modules/ThreadPool.hpp"
 #include "../systems/AIPerceptionSystem.hpp"
 #include "../systems/System.hpp"
 #include <cmath>
 #include <easys/easys.hpp>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 // The AISystem class is responsible for coordinating all AI-related subsystems, including perception, decision-making,
 // and actions.
 class AISystem final : public System {
   public:
-	AISystem(BTManager &btManager_, const MapManager &mapManager) : btManager(btManager_), perceptionSystem(mapManager)
+	// aiFrameBudget is the time ticking trees may take per frame, see AIScheduler.
+	AISystem(BTManager &btManager_, const MapManager &mapManager, ThreadPool &threadPool_, InfluenceMap &influenceMap_,
+	         const Events &events, const double aiFrameBudget = AIScheduler::FRAME_BUDGET)
+	    : btManager(btManager_), perceptionSystem(mapManager, events), scheduler(aiFrameBudget),
+	      threadPool(threadPool_), influenceMap(influenceMap_), commandLists(threadPool_.getThreadCount())
 	{
 	}
 
 	void update(Easys::ECS &ecs, const double deltaTime)
 	{
-		const std::set<Easys::Entity> entities = ecs.getEntities();
-
 		perceptionSystem.update(ecs, deltaTime);
-		btManager.setGlobalTreeValue<double>("deltaTime", deltaTime);
+		influenceMap.update(ecs, deltaTime); // after perception, since it remembers the enemies seen this frame
 		// Update state machine for high-level decisions (currently done within the loop down below)
 		// stateMachine.updateState(ecs, entity, deltaTime);
 
-		// act
-		for (const Easys::Entity &entity : entities) {
-			if (ecs.hasComponent<AI>(entity)) {
-				AI &ai = ecs.getComponent<AI>(entity);
-
-				if (ecs.hasComponent<Vision>(entity)) {
-					Vision &vision = ecs.getComponent<Vision>(entity);
+		for (const Easys::Entity &entity : ecs.getEntities()) {
+			if (ecs.hasComponent<AI>(entity) && ecs.hasComponent<Vision>(entity)) {
+				updateHighLevelAIState(ecs, entity, deltaTime);
+			}
+		}
 
-					updateHighLevelAIState(ecs, entity, deltaTime);
+		// act. Trees are ticked at a lower rate depending on their state and distance to the player's squad. Compiled
+		// trees are ticked in parallel and only read the ECS, their writes are applied afterwards. Trees running on
+		// BehaviorTree.CPP write to the ECS directly, so they are ticked on this thread once the others are done.
+		scheduler.run(ecs, deltaTime, threadPool,
+		              [&](const Easys::Entity entity, const double elapsedTime, const std::size_t threadIndex) {
+			              if (!ecs.hasComponent<Vision>(entity)) {
+				              return;
+			              }
+
+			              if (btManager.hasCompiledTree(entity)) {
+				              btManager.tickCompiledTree(entity, elapsedTime, commandLists[threadIndex]);
+			              } else {
+				              std::lock_guard<std::mutex> lock(serialTicksMutex);
+				              serialTicks.push_back({entity, elapsedTime});
+			              }
+		              });
+
+		for (AICommands &commands : commandLists) {
+			commands.apply(ecs);
+		}
 
-					btManager.tickTree(entity);
-				}
-			}
+		for (const auto &[entity, elapsedTime] : serialTicks) {
+			btManager.tickTree(entity, elapsedTime);
 		}
+		serialTicks.clear();
 	}
 
   private:
@@ -103,6 +130,7 @@ class AISystem final : public System {
 			if (vision.visibleEnemies.empty()) {
 				ai.previousState = currentState;
 				ai.state = AIState::Searching;
+				searchLastKnownEnemy(ecs, entity, position);
 			}
 			break;
 
@@ -112,7 +140,29 @@ class AISystem final : public System {
 		}
 	}
 
+	// Sends a guard which lost sight of the squad to where an enemy was seen most recently (see InfluenceMap). The trees
+	// have no branch for searching, so nothing else moves the guard until the search times out.
+	void searchLastKnownEnemy(Easys::ECS &ecs, const Easys::Entity entity, const Vec2f &position) const
+	{
+		if (!ecs.hasComponent<Pathfinding>(entity)) {
+			return;
+		}
+
+		const std::optional<Vec2i> tile =
+		    influenceMap.findLastKnownEnemy(Utils::toTileSize(position), SEARCH_RADIUS);
+		if (tile) {
+			ecs.getComponent<Pathfinding>(entity).targetPosition = *tile * TILE_SIZE;
+		}
+	}
+
 	AIPerceptionSystem perceptionSystem;
+	AIScheduler scheduler;
+
+	ThreadPool &threadPool;
+	InfluenceMap &influenceMap;
+	std::vector<AICommands> commandLists; // one per thread
+	std::vector<std::pair<Easys::Entity, double>> serialTicks;
+	std::mutex serialTicksMutex;
 
 	// AIStateMachine stateMachine;
 
@@ -7,6 +7,7 @@
 #include "../engine/Engine.hpp"
 #include "../map/MapManager.hpp"
 #include "../modules/Camera.hpp"
+#include "../modules/Query.hpp"
 #include "../modules/Utils.hpp"
 #include "System.hpp"
 #include <cmath>
@@ -17,22 +18,17 @@
 // The AnimationSystem is TODO.
 class AnimationSystem final : public System {
   public:
-	AnimationSystem(const Engine &engine, const MapManager &mapManager, const Camera &camera)
-	    : engine_(engine), mapManager_(mapManager), camera_(camera)
+	AnimationSystem(const Engine &engine, const MapManager &mapManager, const Camera &camera, QueryRegistry &queries)
+	    : engine_(engine), mapManager_(mapManager), camera_(camera), animatables_(queries.get<Animatable, Renderable>())
 	{
 	}
 
 	void update(Easys::ECS &ecs, const double deltaTime) override
 	{
-		const std::set<Easys::Entity> &entities = ecs.getEntities();
-		for (const Easys::Entity &entity : entities) {
-			if (ecs.hasComponent<Animatable>(entity) && ecs.hasComponent<Renderable>(entity)) {
-				auto &sourcePosition = ecs.getComponent<Renderable>(entity).sourcePosition;
-				auto &animatable = ecs.getComponent<Animatable>(entity);
-				animatable.timeElapsed += deltaTime;
-				handleAnimation(ecs, entity, animatable, sourcePosition.y);
-			}
-		}
+		animatables_.forEach([&](const Easys::Entity entity, Animatable &animatable, Renderable &renderable) {
+			animatable.timeElapsed += deltaTime;
+			handleAnimation(ecs, entity, animatable, renderable.sourcePosition.y);
+		});
 	}
 
   private:
@@ -55,4 +51,5 @@ class AnimationSystem final : public System {
 	const Engine &engine_;
 	const MapManager &mapManager_; // Maybe needed in the future if we want to animate tiles (e.g. water, trees)
 	const Camera &camera_;
+	Query<Animatable, Renderable> &animatables_;
 };
@@ -1,4 +1,5 @@
-#include "../components/SoundEmitter.hpp"
+#include "../components/EquippedWeapon.hpp"
+#include "../modules/Events.hpp"
 #include "System.hpp"
 #include <SDL.h>
 #include <easys/easys.hpp>
@@ -7,7 +8,8 @@
 
 class AudioSystem final : public System {
   public:
-	explicit AudioSystem(Engine &engine, const Camera &camera) : engine_(engine), camera_(camera)
+	AudioSystem(Engine &engine, const Camera &camera, const Events &events)
+	    : engine_(engine), camera_(camera), events_(events)
 	{
 		audioDevice_.setVolume(50);
 		// assumes that game starts in main menu
@@ -16,67 +18,58 @@ class AudioSystem final : public System {
 
 	void update(Easys::ECS &ecs, const double deltaTime) override
 	{
-		// Start Ingame Background Music at Start of Game loop
-		if (!backgroundMusic_) {
-			backgroundMusic_ = audioDevice_.loadMusicFile(BACKGROUND_JUNGLE_AMBIENCE);
+		// Start Ingame Background Music at Start of Game loop, it was opened at startup (see SoundBank)
+		if (!isPlayingBackgroundMusic_) {
 			audioDevice_.streamMusic(backgroundMusic_, -1);
+			isPlayingBackgroundMusic_ = true;
 		}
 
-		// testing to check for isMoving here or not could work well
-		const std::set<Easys::Entity> &entities = ecs.getEntities();
-		for (Easys::Entity entity : entities) {
-			if (ecs.hasComponent<RigidBody>(entity)) {
-				RigidBody &rigidBody = ecs.getComponent<RigidBody>(entity);
-				if (rigidBody.isMoving) {
-					if (!ecs.hasComponent<SoundEmitter>(entity)) {
-						ecs.addComponent<SoundEmitter>(entity, {footStep_Ptr_}); // TODO --> MOVE TO RELEVANT SYSTEM
-					}
-				}
-				if (rigidBody.isShooting) {
-					if (!ecs.hasComponent<SoundEmitter>(entity)) {
-						ecs.addComponent<SoundEmitter>(entity, {akShot_Ptr_}); // TODO --> MOVE TO RELEVANT SYSTEM
-						rigidBody.isShooting = false;                          // move to input system or whereever
-					}
-				}
-				// this part stops emission of shot sounds when reloading -> Hack, TODO --> enable loading and
-				// randomizing
-				if (ecs.hasComponent<EquippedWeapon>(entity)) {
-					if (ecs.getComponent<EquippedWeapon>(entity).isReloading) {
-						int channelToHalt =
-						    audioDevice_.getChannelManager().whereIsEmitterPlayingThis(entity, akShot_Ptr_);
-						audioDevice_.stopEmission(channelToHalt);
-					}
-				}
+		// this part stops emission of shot sounds when reloading -> Hack, TODO --> enable loading and
+		// randomizing. Only the playing voices are checked, not every armed entity.
+		const ChannelManager &channelManager = audioDevice_.getChannelManager();
+		for (int channel = 0; channel < AudioConfig::VIRTUAL_CHANNELS; channel++) {
+			const ChannelManager::ChannelData &data = channelManager.getChannelData(channel);
+			if (data.activeTrack_Ptr == akShot_Ptr_ && isReloading(ecs, data.emitterID)) {
+				audioDevice_.stopEmission(channel);
 			}
 		}
-		for (const Easys::Entity &entity : entities) {
 
-			if (ecs.hasComponent<SoundEmitter>(entity)) {
-				SoundEmitter soundEffect = ecs.getComponent<SoundEmitter>(entity);
-				Vec2f &emitterPosition = ecs.getComponent<Positionable>(entity).position;
-				Vec2f listenerPosition = camera_.getPosition() + (Utils::toFloat(engine_.getScreenSize()) / 2);
-				if (soundEffect.soundFile_Ptr == footStep_Ptr_ && entity == PLAYER) {
-					audioDevice_.emit3D(entity, footStep_Ptr_, emitterPosition, listenerPosition, {});
-				} else if (soundEffect.soundFile_Ptr == akShot_Ptr_) {
-					audioDevice_.emit3D(entity, akShot_Ptr_, emitterPosition, listenerPosition, {});
-				}
+		// The sounds are pushed by the systems making them (footsteps by the PhysicsSystem, shots by the FiringSystem)
+		// and get their channels by priority, far away sounds are culled (see Audio::playQueuedEmissions).
+		for (const SoundEvent &sound : events_.sounds) {
+			if (sound.type == NoiseType::Footstep && sound.entity == PLAYER) {
+				audioDevice_.queueEmission3D(sound.entity, footStep_Ptr_, sound.position,
+				                             {.priority = FOOTSTEP_PRIORITY});
+			} else if (sound.type == NoiseType::Gunshot) {
+				audioDevice_.queueEmission3D(sound.entity, akShot_Ptr_, sound.position, {.priority = GUNSHOT_PRIORITY});
 			}
-			ecs.removeComponent<SoundEmitter>(entity);
 		}
+		Vec2f listenerPosition = camera_.getPosition() + (Utils::toFloat(engine_.getScreenSize()) / 2);
+		audioDevice_.playQueuedEmissions(listenerPosition);
 	}
 
   private:
+	static constexpr int FOOTSTEP_PRIORITY = 0;
+	static constexpr int GUNSHOT_PRIORITY = 1; // shots tell the player about combat, so they win over footsteps
+
+	static bool isReloading(Easys::ECS &ecs, const int emitterID)
+	{
+		const Easys::Entity entity = static_cast<Easys::Entity>(emitterID);
+		return emitterID >= 0 && ecs.hasEntity(entity) && ecs.hasComponent<EquippedWeapon>(entity) &&
+		       ecs.getComponent<EquippedWeapon>(entity).isReloading;
+	}
+
 	Engine &engine_;
 	Audio &audioDevice_ =
 	    engine_
 	        .getAudioDevice(); // lets try to change this to only need the audio and not the whole engine -> low prio
 	const Camera &camera_;
+	const Events &events_;
 
-	// internal types and pointers
-	Music mainMenuMusic_ = audioDevice_.loadMusicFile(BACKGROUND_MAIN_MENU);
-	Music backgroundMusic_;
-	std::shared_ptr<SoundEffect> footStep_Ptr_ = std::make_shared<SoundEffect>(
-	    audioDevice_.loadSoundEffectFile(SFX_FOOTSTEP)); // probably SoundEffect should be a pointer by itself?
-	std::shared_ptr<SoundEffect> akShot_Ptr_ =
-	    std::make_shared<SoundEffect>(audioDevice_.loadSoundEffectFile(SFX_AK_SHOT_FULL_AUTO_LONG));
+	// internal types and pointers, owned by the sound bank which loaded them at startup
+	const Music &mainMenuMusic_ = audioDevice_.getSoundBank().getMusic(BACKGROUND_MAIN_MENU);
+	const Music &backgroundMusic_ = audioDevice_.getSoundBank().getMusic(BACKGROUND_JUNGLE_AMBIENCE);
+	bool isPlayingBackgroundMusic_ = false;
+	std::shared_ptr<SoundEffect> footStep_Ptr_ = audioDevice_.getSoundBank().getSoundEffect(SFX_FOOTSTEP);
+	std::shared_ptr<SoundEffect> akShot_Ptr_ = audioDevice_.getSoundBank().getSoundEffect(SFX_AK_SHOT_FULL_AUTO_LONG);
 };
\ No newline at end of file
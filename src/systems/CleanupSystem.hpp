@@ -1,21 +1,31 @@
-#include "../components/Tombstone.hpp"
+#include "../modules/BTManager.hpp"
+#include "../modules/CommandBuffer.hpp"
+#include "../modules/Events.hpp"
 #include "System.hpp"
 #include <easys/easys.hpp>
 
-// Handles the removal of entities marked for deletion by looking for a tombstone component.
+// Handles the removal of entities for which a DestroyRequest was published. The entities are removed when the command
+// buffer is played back. Their behavior trees are released right away, so they can be reused by entities spawned in
+// the meantime.
 class CleanupSystem : System {
   public:
-	CleanupSystem() = default;
+	CleanupSystem(const Events &events, CommandBuffer &commandBuffer, BTManager &btManager)
+	    : events_(events), commandBuffer_(commandBuffer), btManager_(btManager)
+	{
+	}
 
 	void update(Easys::ECS &ecs, double deltaTime)
 	{
-		const auto entities = ecs.getEntities();
-		for (const auto &entity : entities) {
-			if (ecs.hasComponent<Tombstone>(entity)) {
-				ecs.removeEntity(entity);
+		events_.destroy.forEachEntity([&](const Easys::Entity entity, auto, auto) {
+			if (ecs.hasEntity(entity)) {
+				btManager_.removeTreeForEntity(entity);
+				commandBuffer_.removeEntity(entity);
 			}
-		}
+		});
 	}
 
   private:
-};
\ No newline at end of file
+	const Events &events_;
+	CommandBuffer &commandBuffer_;
+	BTManager &btManager_;
+};
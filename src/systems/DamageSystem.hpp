@@ -1,34 +1,36 @@
-#include "../components/DamageBuffer.hpp"
 #include "../components/Health.hpp"
+#include "../modules/Events.hpp"
 #include "System.hpp"
 #include <easys/easys.hpp>
 
+// Applies the damage events published this frame and asks for the removal of entities which died.
 class DamageSystem : System {
   public:
-	DamageSystem() = default;
+	explicit DamageSystem(Events &events) : events_(events) {}
 
 	void update(Easys::ECS &ecs, double deltaTime)
 	{
-		auto entities = ecs.getEntities();
-		for (const auto &entity : entities) {
-			if (!ecs.hasComponent<Health>(entity) || !ecs.hasComponent<DamageBuffer>(entity)) {
-				continue;
+		events_.damage.forEachEntity([&](const Easys::Entity entity, auto first, auto last) {
+			// the target might have been removed since the damage was dealt
+			if (!ecs.hasEntity(entity) || !ecs.hasComponent<Health>(entity)) {
+				return;
 			}
 
-			const DamageBuffer &dmgBuffer = ecs.getComponent<DamageBuffer>(entity);
 			Health &health = ecs.getComponent<Health>(entity);
+			if (health.health <= 0) {
+				return; // already dead
+			}
 
-			for (const DamageEvent &de : dmgBuffer.damageEvents) {
-				health.health = std::max(0, health.health - de.amount);
-
-				if (health.health <= 0) {
-					ecs.addComponent<Tombstone>(entity, {});
-				}
+			for (auto it = first; it != last; ++it) {
+				health.health = std::max(0, health.health - it->amount);
 			}
 
-			ecs.removeComponent<DamageBuffer>(entity);
-		}
+			if (health.health <= 0) {
+				events_.destroy.push(DestroyRequest{entity});
+			}
+		});
 	}
 
   private:
-};
\ No newline at end of file
+	Events &events_;
+};
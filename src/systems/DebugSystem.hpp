@@ -8,13 +8,15 @@
 #include "../engine/types/Vec2f.hpp"
 #include "../map/MapManager.hpp"
 #include "../modules/Camera.hpp"
+#include "../modules/Query.hpp"
 #include "System.hpp"
 #include <easys/easys.hpp>
 
 class DebugSystem : public System {
   public:
-	DebugSystem(const Engine &engine, const MapManager &mapManager, const Camera &camera)
-	    : engine_(engine), mapManager_(mapManager), camera_(camera)
+	DebugSystem(const Engine &engine, const MapManager &mapManager, const Camera &camera, QueryRegistry &queries)
+	    : engine_(engine), mapManager_(mapManager), camera_(camera), observers_(queries.get<Vision, Positionable>()),
+	      pathfinders_(queries.get<Pathfinding>())
 	{
 	}
 
@@ -27,15 +29,12 @@ class DebugSystem : public System {
   private:
 	void renderVisionDebug(Easys::ECS &ecs) const
 	{
-		for (const auto &entity : ecs.getEntities()) {
-			if (ecs.hasComponent<Vision>(entity)) {
-				auto pos = ecs.getComponent<Positionable>(entity).position;
-				auto vision = ecs.getComponent<Vision>(entity);
-
-				// drawViewCone(ecs, entity);
-				drawLinesOfSight(ecs, entity, vision.visibleAllies, {0, 255, 0, 255});
-				drawLinesOfSight(ecs, entity, vision.visibleEnemies, {255, 120, 80, 255});
-			}
+		for (const auto &entity : observers_) {
+			const auto &vision = ecs.getComponent<Vision>(entity);
+
+			// drawViewCone(ecs, entity);
+			drawLinesOfSight(ecs, entity, vision.visibleAllies, {0, 255, 0, 255});
+			drawLinesOfSight(ecs, entity, vision.visibleEnemies, {255, 120, 80, 255});
 		}
 	}
 
@@ -91,17 +90,15 @@ class DebugSystem : public System {
 
 	void renderPaths(Easys::ECS &ecs) const
 	{
-		for (const auto &entity : ecs.getEntities()) {
-			if (ecs.hasComponent<Pathfinding>(entity)) {
-				const auto &pf = ecs.getComponent<Pathfinding>(entity);
-				for (size_t i = pf.pathIndex; i < pf.path.size(); i++) {
-					if (i + 1 < pf.path.size())
-						engine_.drawLine(screenOffset(Utils::toFloat(pf.path[i])),
-						                 screenOffset(Utils::toFloat(pf.path[i + 1])), {255, 255, 255, 255});
-				}
-				engine_.drawCircle(screenOffset(Utils::toFloat(pf.targetPosition)), (TILE_SIZE / 2) * camera_.getZoom(),
-				                   {255, 255, 255, 255});
+		for (const auto &entity : pathfinders_) {
+			const auto &pf = ecs.getComponent<Pathfinding>(entity);
+			for (size_t i = pf.pathIndex; i < pf.path.size(); i++) {
+				if (i + 1 < pf.path.size())
+					engine_.drawLine(screenOffset(Utils::toFloat(pf.path[i])),
+					                 screenOffset(Utils::toFloat(pf.path[i + 1])), {255, 255, 255, 255});
 			}
+			engine_.drawCircle(screenOffset(Utils::toFloat(pf.targetPosition)), (TILE_SIZE / 2) * camera_.getZoom(),
+			                   {255, 255, 255, 255});
 		}
 	}
 
@@ -116,4 +113,6 @@ class DebugSystem : public System {
 	const Engine &engine_;
 	const MapManager &mapManager_;
 	const Camera &camera_;
+	const Query<Vision, Positionable> &observers_;
+	const Query<Pathfinding> &pathfinders_;
 };
\ No newline at end of file
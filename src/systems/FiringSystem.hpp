@@ -1,9 +1,17 @@
+#include "../components/Collider.hpp"
 #include "../components/EquippedWeapon.hpp"
+#include "../components/Pathfinding.hpp"
 #include "../components/Positionable.hpp"
+#include "../components/RigidBody.hpp"
 #include "../components/Target.hpp"
-#include "../engine/Engine.hpp"
 #include "../entities/projectile.hpp"
-#include "../modules/Camera.hpp"
+#include "../map/MapManager.hpp"
+#include "../modules/CommandBuffer.hpp"
+#include "../modules/EntityHandle.hpp"
+#include "../modules/Events.hpp"
+#include "../modules/HitscanBatch.hpp"
+#include "../modules/ProjectilePool.hpp"
+#include "../modules/Query.hpp"
 #include "../modules/StateMachine.hpp"
 #include "System.hpp"
 #include <easys/easys.hpp>
@@ -11,24 +19,35 @@
 
 class FiringSystem final : public System {
   public:
-	explicit FiringSystem(const Engine &engine) : engine_(engine)
+	FiringSystem(const MapManager &mapManager, ProjectilePool &projectiles, Events &events,
+	             CommandBuffer &commandBuffer, const EntityGenerations &generations, QueryRegistry &queries)
+	    : mapManager_(mapManager), projectiles_(projectiles), events_(events), commandBuffer_(commandBuffer),
+	      generations_(generations), armed_(queries.get<EquippedWeapon, Positionable>()),
+	      colliders_(queries.get<Collider, Positionable>())
 	{
 	}
 
 	void update(Easys::ECS &ecs, const double deltaTime) override
 	{
-		const Vec2i mousePos = engine_.getMousePosition();
-		const std::set<Easys::Entity> &entities = ecs.getEntities(); // no need to iterate over all entities
+		for (const Easys::Entity &entity : armed_) {
+			handleFiring(ecs, entity, deltaTime);
+		}
 
-		for (const Easys::Entity &entity : entities) {
-			if (ecs.hasComponent<EquippedWeapon>(entity) && ecs.hasComponent<Positionable>(entity)) {
-				handleFiring(ecs, entity, deltaTime);
-			}
+		// all shots of hitscan weapons fired this frame are resolved together
+		for (const HitscanHit &hit : hitscanShots.resolve(ecs, mapManager_.getImpenetrableGrid(), colliders_)) {
+			events_.damage.push(DamageEvent{hit.target, hit.shooter, hit.damage});
 		}
 	}
 
   private:
-	const Engine &engine_;
+	const MapManager &mapManager_;
+	ProjectilePool &projectiles_;
+	Events &events_;
+	CommandBuffer &commandBuffer_;
+	const EntityGenerations &generations_;
+	Query<EquippedWeapon, Positionable> &armed_;
+	Query<Collider, Positionable> &colliders_;
+	HitscanBatch hitscanShots;
 
 	// we either need to store the SM within a component or we use a dedicated SMManager and just use entitiy ids to
 	// index the correct SM, like we are doing with e.g. BTManager.
@@ -73,10 +92,10 @@ class FiringSystem final : public System {
 		return targetPosition + targetVelocity * timeToImpact;
 	}
 
-	void handleFiring(Easys::ECS &ecs, const Easys::Entity &entity, const double deltaTime) const
+	void handleFiring(Easys::ECS &ecs, const Easys::Entity &entity, const double deltaTime)
 	{
 		EquippedWeapon &ew = ecs.getComponent<EquippedWeapon>(entity);
-		WeaponMetadata wdata = WeaponDatabase::getInstance().get(ew.weaponId);
+		const WeaponStats &wdata = WeaponDatabase::getInstance().getStats(ew.weaponId);
 
 		bool &isReloading = ecs.getComponent<EquippedWeapon>(entity).isReloading;
 
@@ -104,12 +123,11 @@ class FiringSystem final : public System {
 			ew.warmupAccumulator = 0.f;
 		}
 
-		bool &isShooting = ecs.getComponent<RigidBody>(entity).isShooting;
 		if (ecs.hasComponent<Target>(entity) /* && !isMoving*/) {
-			Target targetComp = ecs.getComponent<Target>(entity);
+			const EntityHandle target = ecs.getComponent<Target>(entity).handle;
 
-			if (!ecs.hasEntity(targetComp.entity)) {
-				ecs.removeComponent<Target>(entity);
+			if (!generations_.isValid(target)) {
+				commandBuffer_.removeComponent<Target>(entity);
 				return;
 			}
 
@@ -127,7 +145,9 @@ class FiringSystem final : public System {
 			}
 
 			// stop moving (should this be in inputsystem / shootat node?)
-			ecs.addComponent<Pathfinding>(entity, {}); // clear any planned movement
+			if (ecs.hasComponent<Pathfinding>(entity)) {
+				ecs.getComponent<Pathfinding>(entity) = Pathfinding{}; // clear any planned movement
+			}
 
 			if (isMoving) {
 				return;
@@ -147,15 +167,23 @@ class FiringSystem final : public System {
 			// spawnProjectile. There we would easily know the size.
 			constexpr float prjOffset = 3.f / 2.f;
 			Vec2f start = ecs.getComponent<Positionable>(entity).position + (TILE_SIZE / 2) - prjOffset;
-			Vec2f targetPos = ecs.getComponent<Positionable>(targetComp.entity).position + (TILE_SIZE / 2) - prjOffset;
-
-			auto rb = ecs.getComponent<RigidBody>(targetComp.entity);
-			Vec2f targetVelocity = (rb.nextPosition - rb.startPosition).norm() * WALK_SPEED;
-			Vec2f leadPos = calculateLead(start, targetPos, wdata.speed, targetVelocity);
-			Vec2f projectileVelocity = (leadPos - start).norm() * wdata.speed;
-
-			spawnProjectile(ecs, start, projectileVelocity, entity, ew.weaponId);
-			isShooting = true;
+			Vec2f targetPos = ecs.getComponent<Positionable>(target.entity).position + (TILE_SIZE / 2) - prjOffset;
+
+			if (wdata.hitscan) {
+				// no lead needed, the shot arrives instantly
+				const Vec2f center = start + prjOffset;
+				const Vec2f end = center + (targetPos - start).norm() * (wdata.range * TILE_SIZE);
+				hitscanShots.add(HitscanShot{entity, center, end, wdata.damage});
+			} else {
+				auto rb = ecs.getComponent<RigidBody>(target.entity);
+				Vec2f targetVelocity = (rb.nextPosition - rb.startPosition).norm() * WALK_SPEED;
+				Vec2f leadPos = calculateLead(start, targetPos, wdata.speed, targetVelocity);
+				Vec2f projectileVelocity = (leadPos - start).norm() * wdata.speed;
+
+				spawnProjectile(projectiles_, start, projectileVelocity, entity, ew.weaponId);
+			}
+			const Vec2f &position = ecs.getComponent<Positionable>(entity).position;
+			events_.sounds.push(SoundEvent{entity, position, NoiseType::Gunshot, NOISE_GUNSHOT});
 		}
 	}
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../components/Controllable.hpp"
+#include "../components/Positionable.hpp"
+#include "../constants.hpp"
+#include "../map/FogOfWar.hpp"
+#include "../map/MapManager.hpp"
+#include "../modules/FieldOfView.hpp"
+#include "../modules/Utils.hpp"
+#include "System.hpp"
+#include <easys/easys.hpp>
+#include <unordered_map>
+
+// Updates the fog of war from the fields of view of all Controllable units.
+//
+// Every unit keeps the field of view it last contributed. When a unit changes its tile, only the difference between
+// the old and the new field of view is applied to the fog, so standing units cost nothing and moving units cost a
+// small window around them, independent of the map size.
+class FogOfWarSystem final : public System {
+  public:
+	FogOfWarSystem(const MapManager &mapManager, FogOfWar &fogOfWar) : mapManager_(mapManager), fogOfWar_(fogOfWar)
+	{
+	}
+
+	void update(Easys::ECS &ecs, const double deltaTime) override
+	{
+		for (const Easys::Entity &entity : ecs.getEntities()) {
+			if (ecs.hasComponent<Controllable>(entity) && ecs.hasComponent<Positionable>(entity)) {
+				const Vec2i tile = Utils::toTileSize(ecs.getComponent<Positionable>(entity).position);
+				FieldOfView &fieldOfView = fieldsOfView[entity];
+
+				if (!fieldOfView.isComputedFor(tile, SQUAD_VISION_RADIUS, forward, angle)) {
+					nextFieldOfView.compute(mapManager_.getObstacleGrid(), tile, SQUAD_VISION_RADIUS, forward, angle);
+					applyDifference(fieldOfView, nextFieldOfView);
+					std::swap(fieldOfView, nextFieldOfView);
+				}
+			}
+		}
+
+		removeLostUnits(ecs);
+	}
+
+  private:
+	void applyDifference(const FieldOfView &previous, const FieldOfView &next)
+	{
+		previous.forEachVisible([&](const Vec2i &tile) {
+			if (!next.isVisible(tile))
+				fogOfWar_.removeViewer(tile);
+		});
+		next.forEachVisible([&](const Vec2i &tile) {
+			if (!previous.isVisible(tile))
+				fogOfWar_.addViewer(tile);
+		});
+	}
+
+	// Units which died or are no longer controllable stop revealing the map.
+	void removeLostUnits(Easys::ECS &ecs)
+	{
+		for (auto it = fieldsOfView.begin(); it != fieldsOfView.end();) {
+			if (ecs.hasEntity(it->first) && ecs.hasComponent<Controllable>(it->first)) {
+				++it;
+				continue;
+			}
+
+			it->second.forEachVisible([&](const Vec2i &tile) { fogOfWar_.removeViewer(tile); });
+			it = fieldsOfView.erase(it);
+		}
+	}
+
+	// units see in every direction
+	static constexpr float angle = 360;
+	const Vec2f forward{0, -1};
+
+	const MapManager &mapManager_;
+	FogOfWar &fogOfWar_;
+	std::unordered_map<Easys::Entity, FieldOfView> fieldsOfView;
+	FieldOfView nextFieldOfView; // reused to avoid reallocations
+};
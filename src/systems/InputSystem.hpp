@@ -6,6 +6,7 @@
 #include "../entities/projectile.hpp"
 #include "../modules/AABB.hpp"
 #include "../modules/Camera.hpp"
+#include "../modules/EntityHandle.hpp"
 #include "../modules/Utils.hpp"
 #include "System.hpp"
 #include <SDL.h>
@@ -17,7 +18,8 @@
 // decide.
 class InputSystem final : public System {
   public:
-	explicit InputSystem(const Engine &engine, Camera &camera) : engine_(engine), camera_(camera)
+	InputSystem(const Engine &engine, Camera &camera, const EntityGenerations &generations)
+	    : engine_(engine), camera_(camera), generations_(generations)
 	{
 	}
 
@@ -47,6 +49,7 @@ class InputSystem final : public System {
   private:
 	const Engine &engine_;
 	Camera &camera_;
+	const EntityGenerations &generations_;
 
 	static constexpr int LEFT_MOUSE_BUTTON = 0;
 	static constexpr int RIGHT_MOUSE_BUTTON = 2;
@@ -65,7 +68,7 @@ class InputSystem final : public System {
 			if (!entities.empty()) {
 				// tile is occupied by entity -> handle engagement
 				if (entity != entities[0]) { // don't allow suicide
-					const Target targetComponent{entities[0]};
+					const Target targetComponent{generations_.getHandle(entities[0])};
 					ecs.addComponent<Target>(entity, targetComponent);
 
 					// cancel current path. currently done in firingsystem
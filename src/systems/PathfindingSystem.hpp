@@ -4,6 +4,7 @@
 #include "../components/RigidBody.hpp"
 #include "../constants.hpp"
 #include "../map/MapManager.hpp"
+#include "../modules/Query.hpp"
 #include "../modules/Utils.hpp"
 #include "System.hpp"
 #include <cmath>
@@ -12,35 +13,28 @@
 
 class PathfindingSystem final : public System {
   public:
-	PathfindingSystem(const MapManager &mapManager) : mapManager_(mapManager)
+	PathfindingSystem(const MapManager &mapManager, QueryRegistry &queries)
+	    : mapManager_(mapManager), pathfinders_(queries.get<RigidBody, Positionable, Pathfinding>())
 	{
 	}
 
 	void update(Easys::ECS &ecs, const double deltaTime) override
 	{
-		const std::set<Easys::Entity> &entities = ecs.getEntities();
+		pathfinders_.forEach([&](const Easys::Entity entity, RigidBody &rigidBody, Positionable &positionable,
+		                         Pathfinding &pf) {
+			// TODO: Should not happen for every entity, but currently this is how we omit checking an entity
+			// against itself.
+			// auto walkableView = populateWalkableView(ecs, entity, mapManager_.getWalkableMapView());
+			auto walkableView = mapManager_.getWalkableMapView();
 
-		for (const Easys::Entity &entity : entities) {
-			if (ecs.hasComponent<RigidBody>(entity) && ecs.hasComponent<Positionable>(entity)) {
-				auto &position = ecs.getComponent<Positionable>(entity).position;
-				auto &rigidBody = ecs.getComponent<RigidBody>(entity);
-				// TODO: Should not happen for every entity, but currently this is how we omit checking an entity
-				// against itself.
-				// auto walkableView = populateWalkableView(ecs, entity, mapManager_.getWalkableMapView());
-				auto walkableView = mapManager_.getWalkableMapView();
-
-				if (ecs.hasComponent<Pathfinding>(entity)) {
-					Collider &collider = ecs.getComponent<Collider>(entity);
-					if (collider.didCollide) {
-						Vec2f lastCollideePosition = Utils::toFloat(Utils::toTileSize(collider.lastCollisionPosition));
-						walkableView[lastCollideePosition.y][lastCollideePosition.x] = 1;
-						collider.didCollide = false;
-					}
-					auto &pf = ecs.getComponent<Pathfinding>(entity);
-					handleAIPathfinding(position, rigidBody, pf, walkableView);
-				}
+			Collider &collider = ecs.getComponent<Collider>(entity);
+			if (collider.didCollide) {
+				Vec2f lastCollideePosition = Utils::toFloat(Utils::toTileSize(collider.lastCollisionPosition));
+				walkableView[lastCollideePosition.y][lastCollideePosition.x] = 1;
+				collider.didCollide = false;
 			}
-		}
+			handleAIPathfinding(positionable.position, rigidBody, pf, walkableView);
+		});
 	}
 
   private:
@@ -89,5 +83,6 @@ class PathfindingSystem final : public System {
 		return walkableView;
 	}
 
-	MapManager mapManager_;
+	const MapManager &mapManager_;
+	Query<RigidBody, Positionable, Pathfinding> &pathfinders_;
 };
@@ -3,6 +3,8 @@
 #include "../components/RigidBody.hpp"
 #include "../constants.hpp"
 #include "../map/MapManager.hpp"
+#include "../modules/Events.hpp"
+#include "../modules/Query.hpp"
 #include "System.hpp"
 #include <cmath>
 #include <easys/easys.hpp>
@@ -19,15 +21,15 @@
 
 class PhysicsSystem final : public System {
   public:
-	PhysicsSystem(const MapManager &mapManager) : mapManager_(mapManager)
+	PhysicsSystem(const MapManager &mapManager, Events &events, QueryRegistry &queries)
+	    : mapManager_(mapManager), events_(events), bodies_(queries.get<RigidBody, Positionable>()),
+	      colliders_(queries.get<Collider, Positionable>())
 	{
 	}
 
 	void update(Easys::ECS &ecs, double deltaTime) override
 	{
-		const auto &entities = ecs.getEntitiesByComponents<RigidBody, Positionable>();
-
-		for (const Easys::Entity &entity : entities) {
+		for (const Easys::Entity &entity : bodies_) {
 			auto &rigidBody = ecs.getComponent<RigidBody>(entity);
 			auto &currentPos = ecs.getComponent<Positionable>(entity).position; // in pixels (float)
 			Vec2f nextPos = Utils::toFloat(rigidBody.nextPosition);
@@ -57,6 +59,7 @@ class PhysicsSystem final : public System {
 			if (distToTarget < 0.01f) {
 				currentPos = nextPos;
 				resetCurrentMovementParams(rigidBody, currentPos);
+				events_.sounds.push(SoundEvent{entity, currentPos, NoiseType::Footstep, NOISE_FOOTSTEP});
 			}
 		}
 	}
@@ -124,8 +127,8 @@ class PhysicsSystem final : public System {
 	bool wouldCollideWithEntity(Easys::ECS &ecs, Easys::Entity entity, const Vec2f &nextPos) const
 	{
 		// TODO: reduce potential O(N) collision checks
-		for (const Easys::Entity &other : ecs.getEntities()) {
-			if (entity != other && ecs.hasComponent<Collider>(other) && ecs.hasComponent<Positionable>(other)) {
+		for (const Easys::Entity &other : colliders_) {
+			if (entity != other) {
 				const auto &otherPosition = ecs.getComponent<Positionable>(other).position;
 				if (Utils::round(otherPosition) == nextPos) {
 					return true;
@@ -152,4 +155,7 @@ class PhysicsSystem final : public System {
 	}
 
 	const MapManager &mapManager_;
+	Events &events_;
+	const Query<RigidBody, Positionable> &bodies_;
+	const Query<Collider, Positionable> &colliders_;
 };
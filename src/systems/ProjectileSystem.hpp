@@ -1,115 +1,153 @@
 #include "../components/Positionable.hpp"
-#include "../components/Projectile.hpp"
-#include "../components/Tombstone.hpp"
 #include "../map/MapManager.hpp"
 #include "../modules/AABB.hpp"
+#include "../modules/Events.hpp"
+#include "../modules/LineOfSight.hpp"
+#include "../modules/ProjectilePool.hpp"
+#include "../modules/Query.hpp"
 #include "System.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <easys/easys.hpp>
-#include <set>
+#include <optional>
+#include <vector>
 
+// Moves the projectiles of the ProjectilePool and removes them when they hit something or run out of range.
+//
+// The movement of all projectiles is computed in one branch-free pass over the pool's arrays, which the compiler can
+// vectorise. Only the collision tests, which depend on the map and on other entities, run per projectile.
 class ProjectileSystem final : public System {
   public:
-	ProjectileSystem(const MapManager &mapmanager) : mapmanager_(mapmanager)
+	static constexpr float PROJECTILE_SIZE = 3;
+
+	ProjectileSystem(const MapManager &mapmanager, ProjectilePool &projectiles, Events &events, QueryRegistry &queries)
+	    : mapmanager_(mapmanager), projectiles_(projectiles), events_(events),
+	      colliders_(queries.get<Collider, Positionable>())
 	{
 	}
 
 	void update(Easys::ECS &ecs, const double deltaTime) override
 	{
-		const std::set<Easys::Entity> &entities = ecs.getEntities();
-
-		for (const Easys::Entity &entity : entities) {
-			if (ecs.hasComponent<Projectile>(entity) && ecs.hasComponent<Positionable>(entity)) {
-				Vec2f &position = ecs.getComponent<Positionable>(entity).position;
-				const Projectile &projectile = ecs.getComponent<Projectile>(entity);
-				const Vec2f startPosition = projectile.startPosition;
-				const Vec2f velocity = projectile.velocity;
-
-				const Vec2f newPosition = position + velocity * deltaTime;
-
-				if (checkCollisionsWithMap(ecs, entity, position)) {
-					ecs.addComponent<Tombstone>(entity, Tombstone{}); // mark projectile to be removed
-					continue;
-				}
-
-				const std::optional<CollisionResult> collision = checkCollisionsWithEntities(ecs, entity, position);
-				if (collision) {
-					applyDamage(ecs, *collision);
-					ecs.addComponent<Tombstone>(entity, Tombstone{}); // mark projectile to be removed
-				}
-
-				if ((position - startPosition).length() > projectile.range * TILE_SIZE) { // could save a sqrt op here
-					ecs.addComponent<Tombstone>(entity, Tombstone{});
-				} else {
-					position = newPosition;
-				}
+		computeMovement(static_cast<float>(deltaTime));
+
+		// Iterates backwards, so removing a projectile only moves one which was already handled into its place.
+		for (std::size_t i = projectiles_.size(); i-- > 0;) {
+			const Vec2f position = projectiles_.getPosition(i);
+			const Vec2f delta{deltaX[i], deltaY[i]};
+
+			// The whole movement of this frame is swept, so fast projectiles cannot skip walls or targets on long
+			// frames.
+			const std::optional<float> mapHit = sweepMap(position, delta);
+			const std::optional<CollisionResult> collision =
+			    sweepEntities(ecs, projectiles_.shooter[i], position, delta, mapHit.value_or(1.0f));
+
+			if (collision) {
+				events_.damage.push(DamageEvent{collision->target, collision->shooter, projectiles_.damage[i]});
+				projectiles_.remove(i);
+			} else if (mapHit || isOutOfRange[i]) {
+				projectiles_.remove(i);
+			} else {
+				projectiles_.x[i] += delta.x;
+				projectiles_.y[i] += delta.y;
 			}
 		}
 	}
 
   private:
 	const MapManager &mapmanager_;
+	ProjectilePool &projectiles_;
+	Events &events_;
+	Query<Collider, Positionable> &colliders_;
+
+	// movement of each projectile during this frame, by index into the pool
+	std::vector<float> deltaX, deltaY;
+	std::vector<std::uint8_t> isOutOfRange;
 
 	struct CollisionResult {
-		// bool didCollide = false; // TODO: probably need something like this, since we always generate a collision
-		// event.
-		//  but do we need to or could we solve this differently?
-		Easys::Entity a = 0;   // entity initiating collision
-		Easys::Entity b = 0;   // entity we are colliding with
-		Vec2f position; // position of collision (wrt. a)
+		Easys::Entity shooter = 0; // entity which fired the projectile
+		Easys::Entity target = 0;  // entity we are colliding with
+		Vec2f position;            // position of the projectile at the time of collision
 	};
 
-	bool checkCollisionsWithMap(Easys::ECS &ecs, const Easys::Entity entity, const Vec2f &position) const
+	// Projectiles running out of range only move the rest of their range.
+	void computeMovement(const float deltaTime)
 	{
-		// TODO: check collision with map
-		// We need to implement a penetrable property for tiles.
-		// Since we change our tileset soon, we'll defer until this is done.
-
-		return false;
+		const std::size_t count = projectiles_.size();
+		deltaX.resize(count);
+		deltaY.resize(count);
+		isOutOfRange.resize(count);
+
+		const float *x = projectiles_.x.data();
+		const float *y = projectiles_.y.data();
+		const float *velocityX = projectiles_.velocityX.data();
+		const float *velocityY = projectiles_.velocityY.data();
+		const float *startX = projectiles_.startX.data();
+		const float *startY = projectiles_.startY.data();
+		const float *range = projectiles_.range.data();
+		float *dx = deltaX.data();
+		float *dy = deltaY.data();
+		std::uint8_t *outOfRange = isOutOfRange.data();
+
+		for (std::size_t i = 0; i < count; i++) {
+			const float travelledX = x[i] - startX[i];
+			const float travelledY = y[i] - startY[i];
+			const float travelled = std::sqrt(travelledX * travelledX + travelledY * travelledY);
+			const float remaining = std::max(0.0f, range[i] - travelled);
+
+			const float stepX = velocityX[i] * deltaTime;
+			const float stepY = velocityY[i] * deltaTime;
+			const float step = std::sqrt(stepX * stepX + stepY * stepY);
+			const bool isLastStep = step >= remaining;
+			const float scale = isLastStep && step > 0.0f ? remaining / step : 1.0f;
+
+			dx[i] = stepX * scale;
+			dy[i] = stepY * scale;
+			outOfRange[i] = isLastStep;
+		}
 	}
 
-	std::optional<CollisionResult> checkCollisionsWithEntities(Easys::ECS &ecs, const Easys::Entity entity,
-	                                                           const Vec2f &position) const
+	// Returns the fraction of delta after which the center of the projectile enters a tile which is not penetrable.
+	std::optional<float> sweepMap(const Vec2f &position, const Vec2f &delta) const
 	{
-		const Easys::Entity shooter = ecs.getComponent<Projectile>(entity).shooter;
+		const BitGrid &impenetrable = mapmanager_.getImpenetrableGrid();
+		const Vec2f center = position + PROJECTILE_SIZE / 2;
 
-		for (const auto &otherEntity : ecs.getEntities()) {
-			if (entity == otherEntity) {
-				continue;
-			}
+		return LineOfSight::traceSegment(center, center + delta, TILE_SIZE, [&impenetrable](int x, int y) {
+			return !impenetrable.isInBounds(x, y) || impenetrable.get(x, y); // projectiles leaving the map are removed
+		});
+	}
 
+	// Returns the first collider hit before maxFraction of delta.
+	std::optional<CollisionResult> sweepEntities(Easys::ECS &ecs, const Easys::Entity shooter, const Vec2f &position,
+	                                             const Vec2f &delta, float maxFraction) const
+	{
+		const Rectf projectileBoundingBox{position.x, position.y, PROJECTILE_SIZE, PROJECTILE_SIZE};
+		// covers the whole movement, to skip colliders which are not close to the projectile's path
+		const Rectf sweptBoundingBox{std::min(position.x, position.x + delta.x),
+		                             std::min(position.y, position.y + delta.y), std::fabs(delta.x) + PROJECTILE_SIZE,
+		                             std::fabs(delta.y) + PROJECTILE_SIZE};
+
+		std::optional<CollisionResult> nearest;
+		for (const auto &otherEntity : colliders_) {
 			if (otherEntity == shooter) {
 				continue;
 			}
 
-			if (ecs.hasComponent<Collider>(otherEntity)) {
-				const Vec2f otherPosition = ecs.getComponent<Positionable>(otherEntity).position;
-				const int size = 3; // TODO: read entity size from component
-				const Rectf projectileBoundingBox{position.x, position.y, size, size};
-				const Rectf otherBoundingBox{otherPosition.x, otherPosition.y, TILE_SIZE, TILE_SIZE};
+			const Vec2f otherPosition = ecs.getComponent<Positionable>(otherEntity).position;
+			const Rectf otherBoundingBox{otherPosition.x, otherPosition.y, TILE_SIZE, TILE_SIZE};
+			if (!AABB::checkCollision(sweptBoundingBox, otherBoundingBox)) {
+				continue;
+			}
 
-				if (AABB::checkCollision(projectileBoundingBox, otherBoundingBox)) {
-					return CollisionResult{entity, otherEntity, position};
-				}
+			const std::optional<float> fraction = AABB::sweep(projectileBoundingBox, delta, otherBoundingBox);
+			if (fraction && *fraction <= maxFraction) {
+				maxFraction = *fraction;
+				nearest = CollisionResult{shooter, otherEntity, position + delta * *fraction};
 			}
 		}
 
-		return std::nullopt;
-	}
-
-	void applyDamage(Easys::ECS &ecs, const CollisionResult &collisionResult)
-	{
-		Projectile prj = ecs.getComponent<Projectile>(collisionResult.a);
-		int amount = prj.damage;
-		Easys::Entity targetEntity = collisionResult.b;
-		DamageEvent dmgEvent{collisionResult.a, amount};
-
-		if (ecs.hasComponent<DamageBuffer>(targetEntity)) {
-			DamageBuffer &dmgBuffer = ecs.getComponent<DamageBuffer>(targetEntity);
-			dmgBuffer.damageEvents.push_back(dmgEvent);
-		} else {
-			DamageBuffer dmgBuffer;
-			dmgBuffer.damageEvents.push_back(dmgEvent);
-			ecs.addComponent<DamageBuffer>(targetEntity, dmgBuffer);
-		}
+		return nearest;
 	}
 };
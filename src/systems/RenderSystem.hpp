@@ -1,26 +1,34 @@
 #include "../components/AI.hpp"
 #include "../components/Animatable.hpp"
+#include "../components/Controllable.hpp"
 #include "../components/Health.hpp"
 #include "../components/Positionable.hpp"
 #include "../components/Renderable.hpp"
 #include "../components/RigidBody.hpp"
 #include "../components/Rotatable.hpp"
 #include "../engine/Engine.hpp"
+#include "../map/FogOfWar.hpp"
 #include "../map/MapManager.hpp"
 #include "../modules/Camera.hpp"
+#include "../modules/ProjectilePool.hpp"
+#include "../modules/Query.hpp"
 #include "../modules/Utils.hpp"
 #include "System.hpp"
 #include <cmath>
 #include <easys/easys.hpp>
 #include <functional>
 #include <iostream>
+#include <vector>
 
 // The RenderSystem is responsible for rendering the map and all entities with Renderable components.
-// It performs visibility culling using the camera's position to avoid unnecessary rendering.
+// It performs visibility culling using the camera's position to avoid unnecessary rendering. Entities outside the
+// squad's sight are hidden and tiles are darkened according to the fog of war.
 class RenderSystem final : public System {
   public:
-	RenderSystem(const Engine &engine, const MapManager &mapManager, const Camera &camera)
-	    : engine_(engine), mapManager_(mapManager), camera_(camera)
+	RenderSystem(Engine &engine, const MapManager &mapManager, const Camera &camera, const FogOfWar &fogOfWar,
+	             const ProjectilePool &projectiles, QueryRegistry &queries)
+	    : engine_(engine), mapManager_(mapManager), camera_(camera), fogOfWar_(fogOfWar), projectiles_(projectiles),
+	      renderables_(queries.get<Renderable, Positionable>())
 	{
 		textures.emplace(SPRITE_SHEET, engine_.loadTexture(SPRITE_SHEET));
 		textures.emplace(M4A1, engine_.loadTexture(M4A1));
@@ -36,14 +44,15 @@ class RenderSystem final : public System {
 
 		renderMap(camView, LayerID::BACKGROUND, LayerID::COSMETIC);
 
-		const std::set<Easys::Entity> &entities = ecs.getEntities();
-		for (const Easys::Entity &entity : entities) {
-			if (ecs.hasComponent<Renderable>(entity) && ecs.hasComponent<Positionable>(entity)) {
+		for (const Easys::Entity &entity : renderables_) {
+			if (isVisibleToSquad(ecs, entity)) {
 				renderEntity(ecs, entity, camView);
 			}
 		}
+		renderProjectiles(camView);
 
 		renderMap(camView, LayerID::FOREGROUND);
+		renderFogOfWar(camView);
 	}
 
   private:
@@ -74,6 +83,56 @@ class RenderSystem final : public System {
 		}
 	}
 
+	void renderFogOfWar(const Rectf &camView) const
+	{
+		const int startX = std::max(0, static_cast<int>(camView.x / TILE_SIZE));
+		const int startY = std::max(0, static_cast<int>(camView.y / TILE_SIZE));
+		const int endX = std::min(fogOfWar_.getWidth(), static_cast<int>((camView.x + camView.w) / TILE_SIZE) + 1);
+		const int endY = std::min(fogOfWar_.getHeight(), static_cast<int>((camView.y + camView.h) / TILE_SIZE) + 1);
+
+		engine_.enableAlphaBlending();
+		for (int y = startY; y < endY; y++) {
+			for (int x = startX; x < endX; x++) {
+				const FogState state = fogOfWar_.getState(x, y);
+				if (state == FogState::Visible) {
+					continue;
+				}
+
+				const Recti dst = {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+				const ColorRGBA color = state == FogState::Explored ? ColorRGBA{0, 0, 0, 140} : ColorRGBA{0, 0, 0, 255};
+				engine_.fillRectangle(camera_.rectToScreen(dst), color);
+			}
+		}
+		engine_.disableAlphaBlending();
+	}
+
+	// All projectiles share one sprite, so they are drawn with a single draw call.
+	void renderProjectiles(const Rectf &camView)
+	{
+		projectileDsts.clear();
+		for (std::size_t i = 0; i < projectiles_.size(); i++) {
+			const Vec2f position = projectiles_.getPosition(i);
+			const Rectf dst = {position.x, position.y, PROJECTILE_SPRITE_SIZE, PROJECTILE_SPRITE_SIZE};
+			if (isVisibleOnScreen(dst, camView) && fogOfWar_.isVisible(Utils::toTileSize(position))) {
+				projectileDsts.push_back(camera_.rectToScreen(dst));
+			}
+		}
+
+		const Vec2i srcPos = Vec2i{0, 13} * TILE_SIZE;
+		const Recti src = {srcPos.x, srcPos.y, PROJECTILE_SPRITE_SIZE, PROJECTILE_SPRITE_SIZE};
+		engine_.drawTextures(getSpritesheet(SPRITE_SHEET), src, projectileDsts);
+	}
+
+	// Our own units are always drawn, everything else only if it stands on a tile the squad currently sees.
+	bool isVisibleToSquad(Easys::ECS &ecs, Easys::Entity entity) const
+	{
+		if (ecs.hasComponent<Controllable>(entity)) {
+			return true;
+		}
+
+		return fogOfWar_.isVisible(Utils::toTileSize(ecs.getComponent<Positionable>(entity).position));
+	}
+
 	bool isVisibleOnScreen(const Rectf &dst, const Rectf &camView) const
 	{
 		const float leftBound = camView.x - TILE_SIZE;
@@ -199,7 +258,7 @@ class RenderSystem final : public System {
 
 	void renderWarmupVisual(const Vec2f &position, const EquippedWeapon &ew) const
 	{
-		const WeaponMetadata wdata = WeaponDatabase::getInstance().get(ew.weaponId);
+		const WeaponStats &wdata = WeaponDatabase::getInstance().getStats(ew.weaponId);
 
 		if (ew.warmupAccumulator == 0 || ew.warmupAccumulator >= wdata.warmup)
 			return;
@@ -214,7 +273,7 @@ class RenderSystem final : public System {
 
 	void renderReloadVisual(const Vec2f &position, const EquippedWeapon &ew) const
 	{
-		auto wdata = WeaponDatabase::getInstance().get(ew.weaponId);
+		const WeaponStats &wdata = WeaponDatabase::getInstance().getStats(ew.weaponId);
 
 		if (ew.reloadTimeAccumulator == 0 || ew.reloadTimeAccumulator >= wdata.reloadTime)
 			return;
@@ -244,9 +303,15 @@ class RenderSystem final : public System {
 		engine_.fillRectangle(dst, {50, 168, 82, 255});
 	}
 
-	const Engine &engine_;
+	Engine &engine_; // not const, because drawing the fog needs alpha blending
 	const MapManager &mapManager_;
 	const Camera &camera_;
+	const FogOfWar &fogOfWar_;
+	const ProjectilePool &projectiles_;
+	Query<Renderable, Positionable> &renderables_;
+
+	static constexpr int PROJECTILE_SPRITE_SIZE = 4;
+	std::vector<Rectf> projectileDsts; // reused every frame
 
 	// we do not have a dedicated resource manager as of now, so we load textures here in the constructor and store them
 	// in this map. we index textures by their respective file paths.
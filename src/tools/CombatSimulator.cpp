@@ -0,0 +1,417 @@
+// Headless batch simulation of small engagements, for balancing weapon_data.csv.
+//
+// Every engagement runs in its own ECS world with the combat and AI systems of the game, but without input, rendering
+// or audio: N guards running MainTree against M squad members which shoot the closest guard they can see. The worlds
+// share the map and the weapon data, which are only read, and are simulated in parallel on all cores. The aggregated
+// outcome of all engagements is appended as one row to a CSV file.
+//
+// Usage: CombatSimulator [--guards N] [--squad M] [--worlds W] [--guard-weapon ID] [--squad-weapon ID]
+//                        [--guards-at X,Y] [--squad-at X,Y] [--spread TILES] [--time-limit SECS] [--out FILE]
+//
+// Like the game, it has to be run from the output directory, so the relative asset paths resolve.
+
+#define SDL_MAIN_HANDLED
+
+#include "../ai/InfluenceMap.hpp"
+#include "../components/Patrol.hpp"
+#include "../components/Target.hpp"
+#include "../constants.hpp"
+#include "../entities/npc.hpp"
+#include "../entities/player.hpp"
+#include "../items/WeaponDatabase.hpp"
+#include "../map/MapManager.hpp"
+#include "../modules/BTManager.hpp"
+#include "../modules/CommandBuffer.hpp"
+#include "../modules/EntityHandle.hpp"
+#include "../modules/Events.hpp"
+#include "../modules/LineOfSight.hpp"
+#include "../modules/ProjectilePool.hpp"
+#include "../modules/Query.hpp"
+#include "../modules/ThreadPool.hpp"
+#include "../modules/Utils.hpp"
+#include "../systems/AISystem.hpp"
+#include "../systems/CleanupSystem.hpp"
+#include "../systems/DamageSystem.hpp"
+#include "../systems/FiringSystem.hpp"
+#include "../systems/PathfindingSystem.hpp"
+#include "../systems/PhysicsSystem.hpp"
+#include "../systems/ProjectileSystem.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr double DELTA_TIME = 1.0 / FPS;
+
+enum Side { GUARDS = 0, SQUAD = 1 };
+
+struct Config {
+	int guards = 3;
+	int squad = 4;
+	int worlds = 1000;
+	WeaponID guardWeapon = 1;
+	WeaponID squadWeapon = 1;
+	Vec2i guardsAt{14, 55};
+	Vec2i squadAt{2, 55};
+	int spread = 2;         // units spawn on random open tiles up to this far from their origin
+	double timeLimit = 120; // simulated seconds, engagements taking longer are a draw
+	std::string out = "combat_simulation.csv";
+};
+
+struct Outcome {
+	int winner = -1; // a Side, -1 for a draw
+	double duration = 0;
+	int shots[2] = {0, 0};
+	int hits[2] = {0, 0};
+	int kills[2] = {0, 0};
+	double timeToKill[2] = {0, 0}; // summed over all kills, from the first hit on the victim to its death
+	bool failed = false;
+};
+
+// One independent engagement. Mirrors the simulation part of Game::onUpdate.
+class CombatWorld {
+  public:
+	CombatWorld(const MapManager &mapManager)
+	    : mapManager_(mapManager),
+	      aiSystem(btManager, mapManager, aiThreads, influenceMap, events, AIScheduler::UNLIMITED_BUDGET),
+	      pathfindingSystem(mapManager, queries), physicsSystem(mapManager, events, queries),
+	      firingSystem(mapManager, projectiles, events, commandBuffer, generations, queries),
+	      projectileSystem(mapManager, projectiles, events, queries), damageSystem(events),
+	      cleanupSystem(events, commandBuffer, btManager)
+	{
+		const LevelMap &map = mapManager.getLevelMap();
+		influenceMap.reset(map.getWidth(), map.getHeight());
+	}
+
+	void spawn(const Config &config, std::mt19937 &random)
+	{
+		squadWeapon = config.squadWeapon;
+		const std::vector<Vec2i> squadTiles = findSpawnTiles(config.squadAt, config.squad, config.spread, random);
+		const std::vector<Vec2i> guardTiles = findSpawnTiles(config.guardsAt, config.guards, config.spread, random);
+
+		const Vec2i toSquad = config.squadAt - config.guardsAt;
+		const Rotation guardRotation = Utils::vec2fToRotation(Utils::toFloat(toSquad));
+		const Rotation squadRotation = Utils::vec2fToRotation(Utils::toFloat(toSquad * -1));
+
+		// the squad is spawned first, so one of its members is PLAYER like in the game
+		for (const Vec2i &tile : squadTiles) {
+			const Easys::Entity entity = instantiatePlayerEntity(ecs, tile, squadRotation);
+			equip(entity, config.squadWeapon);
+			sides[entity] = SQUAD;
+		}
+
+		for (const Vec2i &tile : guardTiles) {
+			const Easys::Entity entity = instantiateNPCEntity(ecs, tile, guardRotation);
+			ecs.addComponent<Patrol>(entity, Patrol{{{tile * TILE_SIZE, guardRotation, config.timeLimit}}});
+			equip(entity, config.guardWeapon);
+			btManager.createTreeForEntity(entity, "MainTree");
+			sides[entity] = GUARDS;
+		}
+
+		alive[SQUAD] = config.squad;
+		alive[GUARDS] = config.guards;
+		queries.rebuild(); // the units are spawned directly into the ECS
+	}
+
+	Outcome run(const double timeLimit)
+	{
+		while (time < timeLimit && alive[GUARDS] > 0 && alive[SQUAD] > 0) {
+			step();
+		}
+
+		outcome.duration = time;
+		if (alive[GUARDS] == 0 && alive[SQUAD] > 0) {
+			outcome.winner = SQUAD;
+		} else if (alive[SQUAD] == 0 && alive[GUARDS] > 0) {
+			outcome.winner = GUARDS;
+		}
+		return outcome;
+	}
+
+  private:
+	void step()
+	{
+		selectSquadTargets();
+		commandBuffer.playback(ecs); // sync point: targets of the squad
+
+		aiSystem.update(ecs, DELTA_TIME);
+		pathfindingSystem.update(ecs, DELTA_TIME);
+		firingSystem.update(ecs, DELTA_TIME);
+		physicsSystem.update(ecs, DELTA_TIME);
+		events.sounds.publish();
+		events.damage.publish();
+		recordShotsAndHits();
+		damageSystem.update(ecs, DELTA_TIME);
+		commandBuffer.playback(ecs);
+
+		projectileSystem.update(ecs, DELTA_TIME);
+
+		events.destroy.publish();
+		recordKills();
+		cleanupSystem.update(ecs, DELTA_TIME);
+		commandBuffer.playback(ecs);
+
+		time += DELTA_TIME;
+	}
+
+	// The squad stands still and shoots at the closest guard it can see.
+	void selectSquadTargets()
+	{
+		const BitGrid &obstacles = mapManager_.getObstacleGrid();
+		for (const auto &[entity, side] : sides) {
+			if (side != SQUAD || !ecs.hasEntity(entity) || ecs.hasComponent<Target>(entity)) {
+				continue;
+			}
+
+			const Vec2f position = ecs.getComponent<Positionable>(entity).position;
+			const float range = WeaponDatabase::getInstance().getStats(squadWeapon).range * TILE_SIZE;
+
+			Easys::Entity closest = 0;
+			float closestDistance = std::numeric_limits<float>::max();
+			for (const auto &[other, otherSide] : sides) {
+				if (otherSide != GUARDS || !ecs.hasEntity(other)) {
+					continue;
+				}
+
+				const Vec2f otherPosition = ecs.getComponent<Positionable>(other).position;
+				const float distance = (otherPosition - position).length();
+				if (distance < closestDistance && distance < range &&
+				    LineOfSight::isVisible(obstacles, Utils::toTileSize(position), Utils::toTileSize(otherPosition))) {
+					closest = other;
+					closestDistance = distance;
+				}
+			}
+
+			if (closestDistance < std::numeric_limits<float>::max()) {
+				commandBuffer.addComponent<Target>(entity, Target{generations.getHandle(closest)});
+			}
+		}
+	}
+
+	void recordShotsAndHits()
+	{
+		for (const SoundEvent &sound : events.sounds) {
+			if (sound.type == NoiseType::Gunshot) {
+				outcome.shots[sides.at(sound.entity)]++;
+			}
+		}
+
+		for (const DamageEvent &damage : events.damage) {
+			outcome.hits[sides.at(damage.source)]++;
+			firstHit.try_emplace(damage.entity, time);
+		}
+	}
+
+	void recordKills()
+	{
+		for (const DestroyRequest &request : events.destroy) {
+			const Side victim = sides.at(request.entity);
+			const Side killer = victim == GUARDS ? SQUAD : GUARDS;
+			outcome.kills[killer]++;
+			outcome.timeToKill[killer] += time - firstHit.at(request.entity);
+			alive[victim]--;
+		}
+	}
+
+	void equip(const Easys::Entity entity, const WeaponID weaponId)
+	{
+		EquippedWeapon &weapon = ecs.getComponent<EquippedWeapon>(entity);
+		weapon.weaponId = weaponId;
+		weapon.magazineSize = WeaponDatabase::getInstance().getStats(weaponId).magazineSize;
+	}
+
+	// Picks count distinct open tiles around origin. Throws if there are not enough of them.
+	std::vector<Vec2i> findSpawnTiles(const Vec2i &origin, const int count, const int spread, std::mt19937 &random)
+	{
+		const BitGrid &obstacles = mapManager_.getObstacleGrid();
+		std::vector<Vec2i> tiles;
+		for (int y = origin.y - spread; y <= origin.y + spread; y++) {
+			for (int x = origin.x - spread; x <= origin.x + spread; x++) {
+				if (obstacles.isInBounds(x, y) && !obstacles.get(x, y)) {
+					tiles.push_back({x, y});
+				}
+			}
+		}
+
+		if (static_cast<int>(tiles.size()) < count) {
+			throw std::runtime_error("Not enough open tiles around " + std::to_string(origin.x) + "," +
+			                         std::to_string(origin.y) + " to spawn " + std::to_string(count) + " units.");
+		}
+
+		std::shuffle(tiles.begin(), tiles.end(), random);
+		tiles.resize(count);
+		return tiles;
+	}
+
+	const MapManager &mapManager_;
+	WeaponID squadWeapon = 0;
+
+	Easys::ECS ecs;
+	QueryRegistry queries{ecs};
+	EntityGenerations generations;
+	CommandBuffer commandBuffer{queries, generations};
+	Events events;
+	ProjectilePool projectiles;
+	InfluenceMap influenceMap;
+	BTManager btManager{ecs, generations};
+	ThreadPool aiThreads{1}; // the worlds already run in parallel
+
+	AISystem aiSystem;
+	PathfindingSystem pathfindingSystem;
+	PhysicsSystem physicsSystem;
+	FiringSystem firingSystem;
+	ProjectileSystem projectileSystem;
+	DamageSystem damageSystem;
+	CleanupSystem cleanupSystem;
+
+	std::unordered_map<Easys::Entity, Side> sides;
+	std::unordered_map<Easys::Entity, double> firstHit;
+	int alive[2] = {0, 0};
+	double time = 0;
+	Outcome outcome;
+};
+
+Vec2i parseTile(const std::string &value)
+{
+	const std::size_t comma = value.find(',');
+	if (comma == std::string::npos) {
+		throw std::invalid_argument("Expected a tile as X,Y but got " + value);
+	}
+	return {std::stoi(value.substr(0, comma)), std::stoi(value.substr(comma + 1))};
+}
+
+Config parseArguments(const int argc, char **argv)
+{
+	Config config;
+	for (int i = 1; i < argc; i += 2) {
+		const std::string flag = argv[i];
+		if (i + 1 >= argc) {
+			throw std::invalid_argument("Missing value for " + flag);
+		}
+		const std::string value = argv[i + 1];
+
+		if (flag == "--guards")
+			config.guards = std::stoi(value);
+		else if (flag == "--squad")
+			config.squad = std::stoi(value);
+		else if (flag == "--worlds")
+			config.worlds = std::stoi(value);
+		else if (flag == "--guard-weapon")
+			config.guardWeapon = std::stoi(value);
+		else if (flag == "--squad-weapon")
+			config.squadWeapon = std::stoi(value);
+		else if (flag == "--guards-at")
+			config.guardsAt = parseTile(value);
+		else if (flag == "--squad-at")
+			config.squadAt = parseTile(value);
+		else if (flag == "--spread")
+			config.spread = std::stoi(value);
+		else if (flag == "--time-limit")
+			config.timeLimit = std::stod(value);
+		else if (flag == "--out")
+			config.out = value;
+		else
+			throw std::invalid_argument("Unknown argument " + flag);
+	}
+	return config;
+}
+
+void writeSummary(const Config &config, const std::vector<Outcome> &outcomes)
+{
+	int wins[2] = {0, 0}, draws = 0, failed = 0;
+	int shots[2] = {0, 0}, hits[2] = {0, 0}, kills[2] = {0, 0};
+	double timeToKill[2] = {0, 0}, duration = 0;
+	for (const Outcome &outcome : outcomes) {
+		if (outcome.failed) {
+			failed++;
+			continue;
+		}
+
+		if (outcome.winner == -1)
+			draws++;
+		else
+			wins[outcome.winner]++;
+
+		duration += outcome.duration;
+		for (int side : {GUARDS, SQUAD}) {
+			shots[side] += outcome.shots[side];
+			hits[side] += outcome.hits[side];
+			kills[side] += outcome.kills[side];
+			timeToKill[side] += outcome.timeToKill[side];
+		}
+	}
+
+	const int finished = static_cast<int>(outcomes.size()) - failed;
+	const auto ratio = [](double a, double b) { return b > 0 ? a / b : 0.0; };
+
+	const bool writeHeader = !std::ifstream(config.out).good();
+	std::ofstream file(config.out, std::ios::app);
+	if (!file) {
+		throw std::runtime_error("Could not open " + config.out);
+	}
+
+	if (writeHeader) {
+		file << "guards,squad,guard_weapon,squad_weapon,worlds,failed,guard_wins,squad_wins,draws,mean_duration (secs),"
+		        "guard_ttk (secs),squad_ttk (secs),guard_hit_rate,squad_hit_rate,guard_shots,squad_shots\n";
+	}
+
+	file << config.guards << ',' << config.squad << ',' << config.guardWeapon << ',' << config.squadWeapon << ','
+	     << outcomes.size() << ',' << failed << ',' << wins[GUARDS] << ',' << wins[SQUAD] << ',' << draws << ','
+	     << ratio(duration, finished) << ',' << ratio(timeToKill[GUARDS], kills[GUARDS]) << ','
+	     << ratio(timeToKill[SQUAD], kills[SQUAD]) << ',' << ratio(hits[GUARDS], shots[GUARDS]) << ','
+	     << ratio(hits[SQUAD], shots[SQUAD]) << ',' << shots[GUARDS] << ',' << shots[SQUAD] << '\n';
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	Config config;
+	try {
+		config = parseArguments(argc, argv);
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << "\n"
+		          << "Usage: CombatSimulator [--guards N] [--squad M] [--worlds W] [--guard-weapon ID] "
+		             "[--squad-weapon ID] [--guards-at X,Y] [--squad-at X,Y] [--spread TILES] [--time-limit SECS] "
+		             "[--out FILE]\n";
+		return 1;
+	}
+
+	// shared by all worlds, only read during the simulation
+	MapManager mapManager;
+	mapManager.loadMap(0);
+	WeaponDatabase::getInstance();
+
+	std::vector<Outcome> outcomes(config.worlds);
+	ThreadPool threadPool;
+	threadPool.parallelFor(outcomes.size(), [&](const std::size_t index, std::size_t) {
+		try {
+			std::mt19937 random(static_cast<std::uint32_t>(index));
+			CombatWorld world(mapManager);
+			world.spawn(config, random);
+			outcomes[index] = world.run(config.timeLimit);
+		} catch (const std::exception &e) {
+			outcomes[index].failed = true;
+			if (index == 0) {
+				std::cerr << e.what() << "\n";
+			}
+		}
+	});
+
+	try {
+		writeSummary(config, outcomes);
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
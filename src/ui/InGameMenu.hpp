@@ -4,6 +4,7 @@
 #include "../constants.hpp"
 #include "../engine/Engine.hpp"
 #include "../engine/types/Vec2i.hpp"
+#include "../modules/CommandBuffer.hpp"
 #include "../modules/SaveGameManager.hpp"
 #include "../ui/MenuStack.hpp"
 #include "ConfirmationMenu.hpp"
@@ -16,11 +17,11 @@
 class InGameMenu final : public ListDialog {
   public:
 	InGameMenu(Engine &game, Easys::ECS &ecs, GameStateManager &gameStateManager, SaveGameManager &saveGameManager,
-	           MenuStack &menuStack)
+	           MenuStack &menuStack, CommandBuffer &commandBuffer)
 	    : ListDialog(game, Vec2i{x, y}, menuWidth_), game_(game), ecs_(ecs), menuStack_(menuStack),
-	      gameStateManager_(gameStateManager), saveGameManager_(saveGameManager)
+	      gameStateManager_(gameStateManager), saveGameManager_(saveGameManager), commandBuffer_(commandBuffer)
 	{
-		setItems({{"ITEMS", [this, &game]() { pushMenu<InventoryMenu>(game); }},
+		setItems({{"ITEMS", [this, &game]() { pushMenu<InventoryMenu>(game, commandBuffer_); }},
 		          {"STATS", [this, &game]() { pushMenu<StatsMenu>(game); }},
 		          {"SAVE", [this, &game]() { confirmAndSave(game); }},
 		          {"LOAD", [this, &game]() { confirmAndLoad(game); }},
@@ -46,6 +47,7 @@ class InGameMenu final : public ListDialog {
 	MenuStack &menuStack_;
 	GameStateManager &gameStateManager_;
 	SaveGameManager &saveGameManager_;
+	CommandBuffer &commandBuffer_;
 	bool openedThisFrame = true;
 
 	static constexpr int margin = 20;
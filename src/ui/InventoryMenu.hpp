@@ -9,6 +9,7 @@
 #include "../constants.hpp"
 #include "../engine/Engine.hpp"
 #include "../engine/types/Vec2i.hpp"
+#include "../modules/CommandBuffer.hpp"
 #include "../modules/SaveGameManager.hpp"
 #include "../ui/MenuStack.hpp"
 #include "ListDialog.hpp"
@@ -19,9 +20,9 @@
 
 class InventoryMenu final : public UIElement {
   public:
-	InventoryMenu(Engine &game, Easys::ECS &ecs, MenuStack &menuStack)
-	    : UIElement(game), game_(game), ecs_(ecs), menuStack_(menuStack), listMenu_(game, Vec2i{x, y}, menuWidth_, 6),
-	      textBox_(game, menuStack)
+	InventoryMenu(Engine &game, Easys::ECS &ecs, MenuStack &menuStack, CommandBuffer &commandBuffer)
+	    : UIElement(game), game_(game), ecs_(ecs), menuStack_(menuStack), commandBuffer_(commandBuffer),
+	      listMenu_(game, Vec2i{x, y}, menuWidth_, 6), textBox_(game, menuStack)
 	{
 		updateInventoryList();
 	}
@@ -46,6 +47,7 @@ class InventoryMenu final : public UIElement {
 	Engine &game_;
 	Easys::ECS &ecs_;
 	MenuStack &menuStack_;
+	CommandBuffer &commandBuffer_;
 	ListDialog listMenu_;
 	TextDialog textBox_;
 
@@ -96,7 +98,7 @@ class InventoryMenu final : public UIElement {
 		if (it != inventory.end()) {
 			inventory.erase(it);
 		}
-		ecs_.removeEntity(itemEntity);
+		commandBuffer_.removeEntity(itemEntity);
 	}
 
 	void updateDescription()
@@ -0,0 +1,128 @@
+#include "../../src/ai/AIScheduler.hpp"
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <map>
+#include <thread>
+
+TEST_CASE("AIScheduler Tests", "[AIScheduler]")
+{
+	constexpr double deltaTime = 1.0 / 120;
+	Easys::ECS ecs;
+	AIScheduler scheduler;
+
+	const Easys::Entity player = ecs.addEntity();
+	ecs.addComponent<Controllable>(player, Controllable{});
+	ecs.addComponent<Positionable>(player, Positionable{{0, 0}});
+
+	SECTION("Tick rates by state and distance")
+	{
+		REQUIRE(AIScheduler::getTickInterval(AIState::Engaging, 100) == 0);
+		REQUIRE(AIScheduler::getTickInterval(AIState::Unaware, 1) == Approx(1.0 / 5));
+		REQUIRE(AIScheduler::getTickInterval(AIState::Searching, 1) == Approx(1.0 / 20));
+		REQUIRE(AIScheduler::getTickInterval(AIState::Searching, 30) == Approx(1.0 / 10));
+		REQUIRE(AIScheduler::getTickInterval(AIState::Unaware, 100) == Approx(1.0 / 2));
+	}
+
+	SECTION("Ticks are staggered and get the accumulated time")
+	{
+		std::vector<Easys::Entity> npcs;
+		for (int i = 0; i < 10; i++) {
+			const Easys::Entity npc = ecs.addEntity();
+			ecs.addComponent<AI>(npc, AI{});
+			ecs.addComponent<Positionable>(npc, Positionable{{float(i * TILE_SIZE), 0}});
+			npcs.push_back(npc);
+		}
+
+		std::map<Easys::Entity, double> tickedTime;
+		std::map<Easys::Entity, int> tickCount;
+		int maxTicksPerFrame = 0;
+		for (int frame = 0; frame < 120; frame++) {
+			int ticks = 0;
+			scheduler.run(ecs, deltaTime, [&](Easys::Entity entity, double elapsedTime) {
+				tickedTime[entity] += elapsedTime;
+				tickCount[entity]++;
+				ticks++;
+			});
+			maxTicksPerFrame = std::max(maxTicksPerFrame, ticks);
+		}
+
+		REQUIRE(maxTicksPerFrame < 10);
+		for (const Easys::Entity npc : npcs) {
+			REQUIRE(tickCount[npc] >= 4);
+			REQUIRE(tickCount[npc] <= 6);
+			REQUIRE(tickedTime[npc] <= 1.0 + 1e-9);
+			REQUIRE(tickedTime[npc] > 1.0 - 1.0 / 5 - 1e-9);
+		}
+	}
+
+	SECTION("Engaging entities tick every frame")
+	{
+		const Easys::Entity npc = ecs.addEntity();
+		AI ai;
+		ai.state = AIState::Engaging;
+		ecs.addComponent<AI>(npc, ai);
+		ecs.addComponent<Positionable>(npc, Positionable{{100 * TILE_SIZE, 0}});
+
+		int ticks = 0;
+		for (int frame = 0; frame < 10; frame++) {
+			scheduler.run(ecs, deltaTime, [&](Easys::Entity, double elapsedTime) {
+				REQUIRE(elapsedTime == Approx(deltaTime));
+				ticks++;
+			});
+		}
+		REQUIRE(ticks == 10);
+	}
+
+	SECTION("The budget defers slow ticks unless it is unlimited")
+	{
+		for (int i = 0; i < 10; i++) {
+			const Easys::Entity npc = ecs.addEntity();
+			ecs.addComponent<AI>(npc, AI{});
+			ecs.addComponent<Positionable>(npc, Positionable{{0, 0}});
+		}
+
+		// every unaware entity is due after a second
+		const auto slowTick = [](Easys::Entity, double) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); };
+		int ticks = 0;
+		scheduler.run(ecs, 1.0, [&](Easys::Entity entity, double elapsedTime) {
+			slowTick(entity, elapsedTime);
+			ticks++;
+		});
+		REQUIRE(ticks < 10);
+
+		AIScheduler unlimited(AIScheduler::UNLIMITED_BUDGET);
+		ticks = 0;
+		unlimited.run(ecs, 1.0, [&](Easys::Entity entity, double elapsedTime) {
+			slowTick(entity, elapsedTime);
+			ticks++;
+		});
+		REQUIRE(ticks == 10);
+	}
+
+	SECTION("Parallel ticks run every due entity once")
+	{
+		ThreadPool pool(4);
+		std::vector<std::atomic<int>> tickCounts(200);
+		std::map<Easys::Entity, std::size_t> indices;
+		for (std::size_t i = 0; i < tickCounts.size(); i++) {
+			const Easys::Entity npc = ecs.addEntity();
+			indices[npc] = i;
+			AI ai;
+			ai.state = AIState::Engaging;
+			ecs.addComponent<AI>(npc, ai);
+			ecs.addComponent<Positionable>(npc, Positionable{{0, 0}});
+		}
+
+		std::atomic<bool> validThreadIndices = true;
+		scheduler.run(ecs, deltaTime, pool, [&](Easys::Entity entity, double, std::size_t threadIndex) {
+			tickCounts[indices.at(entity)]++;
+			if (threadIndex >= pool.getThreadCount())
+				validThreadIndices = false;
+		});
+
+		REQUIRE(validThreadIndices);
+		for (const std::atomic<int> &count : tickCounts) {
+			REQUIRE(count == 1);
+		}
+	}
+}
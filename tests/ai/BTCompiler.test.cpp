@@ -0,0 +1,132 @@
+#include "../../src/ai/BTCompiler.hpp"
+#include "../../src/ai/BTExecutor.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("BTCompiler Tests", "[BTCompiler]")
+{
+	Easys::ECS ecs;
+	BTCompiler compiler;
+	EntityGenerations generations;
+
+	const Easys::Entity npc = ecs.addEntity();
+	ecs.addComponent<AI>(npc, AI{});
+	ecs.addComponent<Rotatable>(npc, Rotatable{NORTH});
+
+	SECTION("Sequence waits for the duration before continuing")
+	{
+		compiler.registerTreesFromText(R"(
+			<root BTCPP_format="4">
+			  <BehaviorTree ID="Wait">
+			    <Sequence>
+			      <IsInState entity="{entity}" state="0" />
+			      <WaitFor entity="{entity}" deltaTime="{deltaTime}" duration="0.5" />
+			      <TurnTo entity="{entity}" direction="EAST" />
+			    </Sequence>
+			  </BehaviorTree>
+			</root>)");
+
+		BTExecutor executor(ecs, generations, compiler.compile("Wait"));
+		executor.addInstance(npc);
+
+		for (int i = 0; i < 4; i++) {
+			REQUIRE(executor.tick(npc, 0.2) == BT::NodeStatus::RUNNING);
+		}
+		REQUIRE(ecs.getComponent<Rotatable>(npc).rotation == NORTH);
+		REQUIRE(executor.tick(npc, 0.2) == BT::NodeStatus::SUCCESS);
+		REQUIRE(ecs.getComponent<Rotatable>(npc).rotation == EAST);
+	}
+
+	SECTION("Subtrees are inlined with remapped entries")
+	{
+		compiler.registerTreesFromText(R"(
+			<root BTCPP_format="4">
+			  <BehaviorTree ID="Main">
+			    <SubTree ID="Turn" entity="{entity}" dir="WEST" />
+			  </BehaviorTree>
+			  <BehaviorTree ID="Turn">
+			    <TurnTo entity="{entity}" direction="{dir}" />
+			  </BehaviorTree>
+			</root>)");
+
+		const CompiledTree tree = compiler.compile("Main");
+		REQUIRE(tree.instructions.size() == 1);
+		REQUIRE(tree.instructions[0].op == OpCode::TurnTo);
+		REQUIRE(tree.instructions[0].ports[0].variable == tree.entity.variable);
+
+		BTExecutor executor(ecs, generations, tree);
+		executor.addInstance(npc);
+		REQUIRE(executor.tick(npc, 0.1) == BT::NodeStatus::SUCCESS);
+		REQUIRE(ecs.getComponent<Rotatable>(npc).rotation == WEST);
+	}
+
+	SECTION("Reactive nodes halt running children when a condition changes")
+	{
+		compiler.registerTreesFromText(R"(
+			<root BTCPP_format="4">
+			  <BehaviorTree ID="Main">
+			    <ReactiveFallback>
+			      <ReactiveSequence>
+			        <IsInState entity="{entity}" state="3" />
+			        <TurnTo entity="{entity}" direction="SOUTH" />
+			      </ReactiveSequence>
+			      <ReactiveSequence>
+			        <IsInState entity="{entity}" state="0" />
+			        <WaitFor entity="{entity}" deltaTime="{deltaTime}" duration="10" />
+			      </ReactiveSequence>
+			    </ReactiveFallback>
+			  </BehaviorTree>
+			</root>)");
+
+		BTExecutor executor(ecs, generations, compiler.compile("Main"));
+		executor.addInstance(npc);
+		REQUIRE(executor.tick(npc, 0.1) == BT::NodeStatus::RUNNING);
+		REQUIRE(executor.tick(npc, 0.1) == BT::NodeStatus::RUNNING);
+
+		ecs.getComponent<AI>(npc).state = AIState::Engaging;
+		REQUIRE(executor.tick(npc, 0.1) == BT::NodeStatus::SUCCESS);
+		REQUIRE(ecs.getComponent<Rotatable>(npc).rotation == SOUTH);
+	}
+
+	SECTION("Instances keep their own state after others are removed")
+	{
+		compiler.registerTreesFromText(R"(
+			<root BTCPP_format="4">
+			  <BehaviorTree ID="Wait">
+			    <Sequence>
+			      <WaitFor entity="{entity}" deltaTime="{deltaTime}" duration="0.1" />
+			      <TurnTo entity="{entity}" direction="EAST" />
+			    </Sequence>
+			  </BehaviorTree>
+			</root>)");
+
+		const Easys::Entity other = ecs.addEntity();
+		ecs.addComponent<Rotatable>(other, Rotatable{NORTH});
+
+		BTExecutor executor(ecs, generations, compiler.compile("Wait"));
+		executor.addInstance(npc);
+		executor.addInstance(other);
+		REQUIRE(executor.tick(other, 0.2) == BT::NodeStatus::RUNNING);
+		REQUIRE(executor.tick(other, 0.2) == BT::NodeStatus::RUNNING);
+
+		executor.removeInstance(npc);
+		REQUIRE_FALSE(executor.hasInstance(npc));
+		REQUIRE(executor.tick(other, 0.2) == BT::NodeStatus::SUCCESS);
+		REQUIRE(ecs.getComponent<Rotatable>(other).rotation == EAST);
+		REQUIRE(ecs.getComponent<Rotatable>(npc).rotation == NORTH);
+	}
+
+	SECTION("Unsupported trees throw")
+	{
+		compiler.registerTreesFromText(R"(
+			<root BTCPP_format="4">
+			  <BehaviorTree ID="Random">
+			    <RandomSelector>
+			      <TurnTo entity="{entity}" direction="EAST" />
+			    </RandomSelector>
+			  </BehaviorTree>
+			</root>)");
+
+		REQUIRE_THROWS_AS(compiler.compile("Random"), std::runtime_error);
+		REQUIRE_THROWS_AS(compiler.compile("Missing"), std::runtime_error);
+	}
+}
@@ -0,0 +1,101 @@
+#include "../../src/ai/InfluenceMap.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("InfluenceMap Tests", "[InfluenceMap]")
+{
+	SECTION("Stamps fall off with distance and are clipped to the map")
+	{
+		InfluenceLayer layer;
+		layer.reset(10, 10, 3);
+		layer.add({0, 0}, 1.0f);
+
+		REQUIRE(layer.get({0, 0}) == Approx(1.0f));
+		REQUIRE(layer.get({1, 0}) == Approx(0.75f));
+		REQUIRE(layer.get({3, 0}) == Approx(0.25f));
+		REQUIRE(layer.get({4, 0}) == 0.0f);
+		REQUIRE(layer.get({-1, 0}) == 0.0f);
+	}
+
+	SECTION("Removing a stamp restores the previous values")
+	{
+		InfluenceLayer layer;
+		layer.reset(10, 10, 3);
+		layer.add({5, 5}, 1.0f);
+		layer.add({8, 9}, 2.0f);
+		layer.remove({5, 5}, 1.0f);
+
+		REQUIRE(layer.get({5, 5}) == Approx(0.0f).margin(1e-6));
+		REQUIRE(layer.get({8, 9}) == Approx(2.0f));
+	}
+
+	SECTION("Raising does not pile up")
+	{
+		InfluenceLayer layer;
+		layer.reset(10, 10, 3);
+		layer.raise({5, 5}, 1.0f);
+		layer.raise({5, 5}, 1.0f);
+		REQUIRE(layer.get({5, 5}) == Approx(1.0f));
+
+		layer.scale(0.5f);
+		REQUIRE(layer.get({5, 5}) == Approx(0.5f));
+	}
+
+	SECTION("Units are moved when they change their tile")
+	{
+		Easys::ECS ecs;
+		InfluenceMap influenceMap;
+		influenceMap.reset(20, 20);
+
+		const Easys::Entity squad = ecs.addEntity();
+		ecs.addComponent<Controllable>(squad, Controllable{});
+		ecs.addComponent<Positionable>(squad, Positionable{Vec2f{2, 2} * TILE_SIZE});
+		const Easys::Entity guard = ecs.addEntity();
+		ecs.addComponent<AI>(guard, AI{});
+		ecs.addComponent<Positionable>(guard, Positionable{Vec2f{15, 15} * TILE_SIZE});
+		Vision vision;
+		vision.visibleEnemies.push_back(squad);
+		ecs.addComponent<Vision>(guard, vision);
+
+		influenceMap.update(ecs, 0.0);
+		REQUIRE(influenceMap.getThreat({2, 2}) == Approx(1.0f));
+		REQUIRE(influenceMap.getAllyDensity({15, 15}) == Approx(1.0f));
+		REQUIRE(influenceMap.getLastKnownEnemyPresence({2, 2}) == Approx(1.0f));
+
+		ecs.getComponent<Positionable>(squad).position = Vec2f{12, 2} * TILE_SIZE;
+		ecs.getComponent<Vision>(guard).visibleEnemies.clear();
+		influenceMap.update(ecs, 1.0);
+		REQUIRE(influenceMap.getThreat({2, 2}) == Approx(0.0f).margin(1e-6));
+		REQUIRE(influenceMap.getThreat({12, 2}) == Approx(1.0f));
+		REQUIRE(influenceMap.getLastKnownEnemyPresence({2, 2}) == Approx(LAST_KNOWN_ENEMY_DECAY));
+
+		ecs.removeEntity(guard);
+		influenceMap.update(ecs, 0.0);
+		REQUIRE(influenceMap.getAllyDensity({15, 15}) == Approx(0.0f).margin(1e-6));
+	}
+
+	SECTION("The most recent sighting nearby is found")
+	{
+		Easys::ECS ecs;
+		InfluenceMap influenceMap;
+		influenceMap.reset(30, 30);
+
+		const Easys::Entity squad = ecs.addEntity();
+		ecs.addComponent<Controllable>(squad, Controllable{});
+		ecs.addComponent<Positionable>(squad, Positionable{Vec2f{4, 4} * TILE_SIZE});
+		const Easys::Entity guard = ecs.addEntity();
+		ecs.addComponent<AI>(guard, AI{});
+		ecs.addComponent<Positionable>(guard, Positionable{Vec2f{10, 4} * TILE_SIZE});
+		Vision vision;
+		vision.visibleEnemies.push_back(squad);
+		ecs.addComponent<Vision>(guard, vision);
+
+		REQUIRE_FALSE(influenceMap.findLastKnownEnemy({10, 4}, 10).has_value());
+
+		influenceMap.update(ecs, 0.0);
+		ecs.getComponent<Positionable>(squad).position = Vec2f{8, 6} * TILE_SIZE;
+		influenceMap.update(ecs, 0.5); // the earlier sighting fades
+
+		REQUIRE(influenceMap.findLastKnownEnemy({10, 4}, 10) == Vec2i{8, 6});
+		REQUIRE(influenceMap.findLastKnownEnemy({25, 25}, 10) == std::nullopt);
+	}
+}
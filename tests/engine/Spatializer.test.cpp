@@ -0,0 +1,85 @@
+#include "../../src/engine/sound/Spatializer.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Spatializer Tests", "[Spatializer]")
+{
+	Spatializer spatializer;
+	std::vector<int> applied;
+	const auto record = [&applied](const int channel, int, int) { applied.push_back(channel); };
+
+	SECTION("Angles and distances match atan2 and the euclidean distance")
+	{
+		const Vec2f listener{100.f, 100.f};
+		const std::vector<Vec2f> offsets = {{30.f, 0.f}, {0.f, 40.f}, {-50.f, 10.f}, {-20.f, -70.f}, {60.f, -5.f}};
+		for (int channel = 0; channel < static_cast<int>(offsets.size()); channel++) {
+			spatializer.setEmitter(channel, listener + offsets[channel], 1, true);
+		}
+		spatializer.update(listener, record);
+
+		for (int channel = 0; channel < static_cast<int>(offsets.size()); channel++) {
+			const Vec2f &offset = offsets[channel];
+			const float expectedAngle = std::atan2(offset.y, offset.x) * 180.f / 3.14159265f;
+			REQUIRE(std::abs(spatializer.getAngle(channel) - expectedAngle) <= 1.f);
+			REQUIRE(std::abs(spatializer.getDistance(channel) - offset.length()) <= 1.f);
+		}
+		REQUIRE(applied.size() == offsets.size());
+	}
+
+	SECTION("Only voices which moved beyond the thresholds are applied again")
+	{
+		spatializer.setEmitter(0, {50.f, 0.f}, 1, true);
+		spatializer.setEmitter(1, {0.f, 50.f}, 1, true);
+		spatializer.update({0.f, 0.f}, record);
+		REQUIRE(applied.size() == 2);
+
+		applied.clear();
+		spatializer.setEmitter(0, {50.5f, 0.f}, 1, false);
+		spatializer.setEmitter(1, {0.f, 80.f}, 1, false);
+		spatializer.update({0.f, 0.f}, record);
+		REQUIRE(applied == std::vector<int>{1});
+	}
+
+	SECTION("A new voice on a channel is always applied")
+	{
+		spatializer.setEmitter(0, {50.f, 0.f}, 1, true);
+		spatializer.update({0.f, 0.f}, record);
+		spatializer.setEmitter(0, {50.f, 0.f}, 1, true);
+		spatializer.update({0.f, 0.f}, record);
+		REQUIRE(applied.size() == 2);
+	}
+
+	SECTION("Released voices and voices out of range settle")
+	{
+		spatializer.setEmitter(0, {50.f, 0.f}, 1, true);
+		spatializer.setEmitter(1, {1000.f, 0.f}, 1, true);
+		spatializer.release(0);
+		spatializer.update({0.f, 0.f}, record);
+		REQUIRE(applied == std::vector<int>{1});
+		REQUIRE(spatializer.getDistance(1) == AudioConfig::MAX_DISTANCE + 1);
+
+		applied.clear();
+		spatializer.setEmitter(1, {2000.f, 0.f}, 1, false);
+		spatializer.update({0.f, 0.f}, record);
+		REQUIRE(applied.empty());
+	}
+
+	SECTION("Voices entering or leaving the range are always applied")
+	{
+		constexpr float edge = static_cast<float>(AudioConfig::MAX_DISTANCE);
+		spatializer.setEmitter(0, {edge + 10.f, 0.f}, 1, true);
+		spatializer.update({0.f, 0.f}, record);
+
+		applied.clear();
+		spatializer.setEmitter(0, {edge, 0.f}, 1, false); // back in range, closer by less than the threshold
+		spatializer.update({0.f, 0.f}, record);
+		REQUIRE(applied == std::vector<int>{0});
+		REQUIRE(spatializer.getDistance(0) == AudioConfig::MAX_DISTANCE);
+
+		applied.clear();
+		spatializer.setEmitter(0, {edge + 1.f, 0.f}, 1, false);
+		spatializer.update({0.f, 0.f}, record);
+		REQUIRE(applied == std::vector<int>{0});
+	}
+}
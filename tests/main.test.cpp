@@ -2,8 +2,28 @@
 
 // These tests currently do not work as we switch to a BT library
 // #include "behaviortree/BehaviorTree.test.hpp"
+#include "ai/AIScheduler.test.cpp"
+#include "ai/BTCompiler.test.cpp"
+#include "ai/InfluenceMap.test.cpp"
 #include "ecs/ECSManager.test.cpp"
 #include "ecs/Registry.test.cpp"
+#include "engine/Spatializer.test.cpp"
 #include "engine/Vec2i.test.cpp" 
+#include "map/CoverMap.test.cpp"
+#include "map/FogOfWar.test.cpp"
+#include "map/TileRegistry.test.cpp"
+#include "modules/AABB.test.cpp"
 #include "modules/AStar.test.cpp"
+#include "modules/BTManager.test.cpp"
+#include "modules/CommandBuffer.test.cpp"
+#include "modules/EntityHandle.test.cpp"
+#include "modules/EventChannel.test.cpp"
+#include "modules/HitscanBatch.test.cpp"
+#include "modules/ProjectilePool.test.cpp"
+#include "modules/Query.test.cpp"
 #include "modules/SaveGameManager.test.cpp"
+#include "modules/SoundPropagation.test.cpp"
+#include "modules/ThreadPool.test.cpp"
+#include "modules/ViewCone.test.cpp"
+#include "modules/LineOfSight.test.cpp"
+#include "modules/FieldOfView.test.cpp"
@@ -0,0 +1,86 @@
+#include "../../src/map/CoverMap.hpp"
+#include <catch2/catch.hpp>
+#include <random>
+
+TEST_CASE("CoverMap Tests", "[CoverMap]")
+{
+	BitGrid obstacles(40, 30);
+	CoverMap coverMap;
+
+	SECTION("Open tiles next to blocking tiles are cover")
+	{
+		obstacles.set(5, 5, true);
+		coverMap.build(obstacles);
+
+		REQUIRE(coverMap.size() == 4);
+		const std::optional<CoverPoint> cover = coverMap.findNearest({5, 8}, {5, 0}, 10);
+		REQUIRE(cover);
+		REQUIRE(cover->tile == Vec2i{5, 6});
+		REQUIRE(cover->protectsFrom(NORTH));
+		REQUIRE_FALSE(cover->protectsFrom(SOUTH));
+	}
+
+	SECTION("Only cover facing the threat is found")
+	{
+		obstacles.set(5, 5, true);
+		coverMap.build(obstacles);
+
+		REQUIRE(coverMap.findNearest({5, 3}, {5, 20}, 10)->tile == Vec2i{5, 4});
+		REQUIRE_FALSE(coverMap.findNearest({30, 20}, {5, 20}, 10));
+	}
+
+	SECTION("Changed tiles are updated")
+	{
+		coverMap.build(obstacles);
+		REQUIRE(coverMap.size() == 0);
+
+		obstacles.set(10, 10, true);
+		coverMap.update(obstacles, {10, 10});
+		REQUIRE(coverMap.size() == 4);
+
+		obstacles.set(10, 10, false);
+		coverMap.update(obstacles, {10, 10});
+		REQUIRE(coverMap.size() == 0);
+	}
+
+	SECTION("Same result as checking every tile")
+	{
+		std::mt19937 random(7);
+		for (int y = 0; y < obstacles.getHeight(); y++) {
+			for (int x = 0; x < obstacles.getWidth(); x++) {
+				obstacles.set(x, y, random() % 12 == 0);
+			}
+		}
+		coverMap.build(obstacles);
+
+		for (int i = 0; i < 200; i++) {
+			const Vec2i from{int(random() % 40), int(random() % 30)};
+			const Vec2i threat{int(random() % 40), int(random() % 30)};
+
+			int nearestDistance = 15 * 15 + 1;
+			for (int y = 0; y < obstacles.getHeight(); y++) {
+				for (int x = 0; x < obstacles.getWidth(); x++) {
+					const Vec2i toThreat = threat - Vec2i{x, y};
+					if (obstacles.get(x, y) || toThreat == Vec2i{0, 0}) {
+						continue;
+					}
+					const Rotation direction = Utils::vec2fToRotation(Vec2f{float(toThreat.x), float(toThreat.y)});
+					const Vec2i neighbour = Vec2i{x, y} + Utils::toInt(Utils::rotationToVec2f(direction));
+					if (obstacles.isInBounds(neighbour) && obstacles.get(neighbour)) {
+						const int distance = (x - from.x) * (x - from.x) + (y - from.y) * (y - from.y);
+						nearestDistance = std::min(nearestDistance, distance);
+					}
+				}
+			}
+
+			const std::optional<CoverPoint> cover = coverMap.findNearest(from, threat, 15);
+			if (nearestDistance > 15 * 15) {
+				REQUIRE_FALSE(cover);
+			} else {
+				REQUIRE(cover);
+				const Vec2i offset = cover->tile - from;
+				REQUIRE(offset.x * offset.x + offset.y * offset.y == nearestDistance);
+			}
+		}
+	}
+}
@@ -0,0 +1,33 @@
+#include "../../src/map/FogOfWar.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("FogOfWar Tests", "[FogOfWar]")
+{
+	FogOfWar fog;
+	fog.reset(10, 8);
+
+	SECTION("Tiles start unexplored")
+	{
+		REQUIRE(fog.getState({0, 0}) == FogState::Unexplored);
+		REQUIRE(fog.getState({9, 7}) == FogState::Unexplored);
+		REQUIRE_FALSE(fog.isVisible({3, 3}));
+		REQUIRE_FALSE(fog.isVisible({10, 3}));
+	}
+
+	SECTION("Tiles stay visible while any unit sees them")
+	{
+		fog.addViewer({3, 3});
+		fog.addViewer({3, 3});
+		REQUIRE(fog.isVisible({3, 3}));
+
+		fog.removeViewer({3, 3});
+		REQUIRE(fog.isVisible({3, 3}));
+
+		fog.removeViewer({3, 3});
+		REQUIRE(fog.getState({3, 3}) == FogState::Explored);
+
+		fog.removeViewer({3, 3}); // does not underflow
+		fog.addViewer({3, 3});
+		REQUIRE(fog.isVisible({3, 3}));
+	}
+}
@@ -0,0 +1,25 @@
+#include "../../src/map/TileRegistry.hpp"
+#include <catch2/catch.hpp>
+#include <stdexcept>
+
+TEST_CASE("TileRegistry Tests", "[TileRegistry]")
+{
+	SECTION("Rows with a penetrable column")
+	{
+		const auto [id, tile] = TileRegistry::parseRow({"7", "1", "0"});
+		REQUIRE(id == 7);
+		REQUIRE(tile.walkable);
+		REQUIRE_FALSE(tile.penetrable);
+	}
+
+	SECTION("Rows without a penetrable column use the walkable value")
+	{
+		REQUIRE(TileRegistry::parseRow({"3", "0"}).second.penetrable == false);
+		REQUIRE(TileRegistry::parseRow({"4", "1"}).second.penetrable == true);
+	}
+
+	SECTION("Rows without a walkable column are rejected")
+	{
+		REQUIRE_THROWS_AS(TileRegistry::parseRow({"5"}), std::runtime_error);
+	}
+}
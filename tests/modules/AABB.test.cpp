@@ -0,0 +1,30 @@
+#include "../../src/modules/AABB.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("AABB Tests", "[AABB]")
+{
+	const Rectf target{100, 0, 32, 32};
+
+	SECTION("Sweeps hit where the boxes first touch")
+	{
+		const std::optional<float> fraction = AABB::sweep({0, 10, 3, 3}, {200, 0}, target);
+		REQUIRE(fraction);
+		REQUIRE(*fraction == Approx(97.0f / 200.0f));
+	}
+
+	SECTION("Fast boxes do not tunnel")
+	{
+		const Rectf projectile{90, 10, 3, 3};
+		REQUIRE_FALSE(AABB::checkCollision(projectile, target));
+		REQUIRE_FALSE(AABB::checkCollision({projectile.x + 100, 10, 3, 3}, target));
+		REQUIRE(AABB::sweep(projectile, {100, 0}, target));
+	}
+
+	SECTION("Misses and overlaps")
+	{
+		REQUIRE_FALSE(AABB::sweep({0, 50, 3, 3}, {200, 0}, target));
+		REQUIRE_FALSE(AABB::sweep({0, 10, 3, 3}, {50, 0}, target));
+		REQUIRE_FALSE(AABB::sweep({0, 10, 3, 3}, {-200, 0}, target));
+		REQUIRE(AABB::sweep({110, 10, 3, 3}, {5, 5}, target) == 0.0f);
+	}
+}
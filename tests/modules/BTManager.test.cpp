@@ -0,0 +1,58 @@
+#include "../../src/modules/BTManager.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+TEST_CASE("BTManager Tests", "[BTManager]")
+{
+	// RandomSelector is not supported by the compiler, so the tree runs on BehaviorTree.CPP and is pooled.
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "btmanager-test-trees";
+	std::filesystem::create_directories(directory);
+	std::ofstream(directory / "Recycled.xml") << R"(
+		<root BTCPP_format="4">
+		  <BehaviorTree ID="Recycled">
+		    <RandomSelector>
+		      <SubTree ID="Chase" entity="{entity}" deltaTime="{deltaTime}" />
+		    </RandomSelector>
+		  </BehaviorTree>
+		  <BehaviorTree ID="Chase">
+		    <ReactiveFallback>
+		      <IsEnemyVisible entity="{entity}" otherEntity="{otherEntity}" otherPosition="{otherPosition}"
+		                      direction="{direction}" />
+		      <MoveTo entity="{entity}" position="{otherPosition}" />
+		    </ReactiveFallback>
+		  </BehaviorTree>
+		</root>)";
+
+	Easys::ECS ecs;
+	EntityGenerations generations;
+	BTManager btManager(ecs, generations, directory.string());
+	std::filesystem::remove_all(directory);
+
+	const auto addGuard = [&ecs]() {
+		const Easys::Entity guard = ecs.addEntity();
+		ecs.addComponent<Positionable>(guard, Positionable{{0, 0}});
+		ecs.addComponent<Rotatable>(guard, Rotatable{NORTH});
+		ecs.addComponent<Vision>(guard, Vision{});
+		ecs.addComponent<Pathfinding>(guard, Pathfinding{});
+		return guard;
+	};
+
+	SECTION("A reused tree does not see the values of the dead entity")
+	{
+		const Easys::Entity enemy = ecs.addEntity();
+		ecs.addComponent<RigidBody>(enemy, RigidBody{false, {64, 32}, {64, 32}});
+
+		const Easys::Entity dead = addGuard();
+		ecs.getComponent<Vision>(dead).visibleEnemies.push_back(enemy);
+		btManager.createTreeForEntity(dead, "Recycled");
+		btManager.tickTree(dead, 0.1); // writes otherPosition
+		btManager.removeTreeForEntity(dead);
+
+		const Easys::Entity spawned = addGuard(); // sees nobody, so MoveTo reads otherPosition
+		btManager.createTreeForEntity(spawned, "Recycled");
+		btManager.tickTree(spawned, 0.1);
+
+		REQUIRE(ecs.getComponent<Pathfinding>(spawned).targetPosition == Vec2i{-1, -1});
+	}
+}
@@ -0,0 +1,63 @@
+#include "../../src/components/Controllable.hpp"
+#include "../../src/components/Health.hpp"
+#include "../../src/modules/CommandBuffer.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("CommandBuffer Tests", "[CommandBuffer]")
+{
+	Easys::ECS ecs;
+	CommandBuffer commandBuffer;
+	const Easys::Entity entity = ecs.addEntity();
+	ecs.addComponent<Health>(entity, Health{100});
+
+	SECTION("Changes are applied on playback")
+	{
+		commandBuffer.addComponent<Controllable>(entity, Controllable{});
+		commandBuffer.removeComponent<Health>(entity);
+		REQUIRE(commandBuffer.size() == 2);
+		REQUIRE_FALSE(ecs.hasComponent<Controllable>(entity));
+		REQUIRE(ecs.hasComponent<Health>(entity));
+
+		commandBuffer.playback(ecs);
+		REQUIRE(commandBuffer.isEmpty());
+		REQUIRE(ecs.hasComponent<Controllable>(entity));
+		REQUIRE_FALSE(ecs.hasComponent<Health>(entity));
+	}
+
+	SECTION("Changes are applied in the order they were recorded")
+	{
+		commandBuffer.addComponent<Health>(entity, Health{50});
+		commandBuffer.removeComponent<Health>(entity);
+		commandBuffer.addComponent<Health>(entity, Health{25});
+		commandBuffer.playback(ecs);
+
+		REQUIRE(ecs.getComponent<Health>(entity).health == 25);
+	}
+
+	SECTION("Changes to removed entities are skipped")
+	{
+		commandBuffer.removeEntity(entity);
+		commandBuffer.addComponent<Controllable>(entity, Controllable{});
+		commandBuffer.removeComponent<Health>(entity);
+		commandBuffer.playback(ecs);
+
+		REQUIRE_FALSE(ecs.hasEntity(entity));
+	}
+
+	SECTION("Systems can record while iterating")
+	{
+		for (int i = 0; i < 10; i++) {
+			ecs.addComponent<Health>(ecs.addEntity(), Health{0});
+		}
+
+		for (const Easys::Entity &e : ecs.getEntities()) {
+			if (ecs.getComponent<Health>(e).health <= 0) {
+				commandBuffer.removeEntity(e);
+			}
+		}
+		commandBuffer.playback(ecs);
+
+		REQUIRE(ecs.getEntities().size() == 1);
+		REQUIRE(ecs.hasEntity(entity));
+	}
+}
@@ -0,0 +1,81 @@
+#include "../../src/components/Health.hpp"
+#include "../../src/modules/CommandBuffer.hpp"
+#include "../../src/modules/EntityHandle.hpp"
+#include "../../src/modules/Query.hpp"
+#include "../../src/modules/SaveGameManager.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+
+TEST_CASE("EntityHandle Tests", "[EntityHandle]")
+{
+	Easys::ECS ecs;
+	QueryRegistry queries(ecs);
+	EntityGenerations generations;
+	CommandBuffer commandBuffer(queries, generations);
+	const Easys::Entity entity = ecs.addEntity();
+	ecs.addComponent<Health>(entity, Health{100});
+
+	SECTION("Handles stay valid until their entity is removed")
+	{
+		const EntityHandle handle = generations.getHandle(entity);
+		REQUIRE(generations.isValid(handle));
+
+		commandBuffer.removeEntity(entity);
+		REQUIRE(generations.isValid(handle));
+
+		commandBuffer.playback(ecs);
+		REQUIRE_FALSE(generations.isValid(handle));
+	}
+
+	SECTION("Handles of a reused id are told apart")
+	{
+		const EntityHandle old = generations.getHandle(entity);
+		generations.onRemoved(entity);
+
+		const EntityHandle current = generations.getHandle(entity); // a new entity with the same id
+		REQUIRE(current.entity == old.entity);
+		REQUIRE_FALSE(current == old);
+		REQUIRE(generations.isValid(current));
+		REQUIRE_FALSE(generations.isValid(old));
+	}
+
+	SECTION("Removing an entity does not affect handles of other entities")
+	{
+		const Easys::Entity other = ecs.addEntity();
+		const EntityHandle handle = generations.getHandle(other);
+
+		commandBuffer.removeEntity(entity);
+		commandBuffer.playback(ecs);
+		REQUIRE(generations.isValid(handle));
+	}
+
+	SECTION("Loading a save game invalidates every handle and drops projectiles and events of the old world")
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "entity-handle-savefile.json").string();
+		ProjectilePool projectiles;
+		Events events;
+		SaveGameManager saveGameManager(ecs, queries, generations, projectiles, events);
+		saveGameManager.save(path);
+
+		const EntityHandle handle = generations.getHandle(entity);
+		const EntityHandle neverRemoved = generations.getHandle(1000);
+		projectiles.spawn({0, 0}, {100, 0}, 500, 10, entity, 1);
+		events.damage.push({entity, entity, 10});
+		saveGameManager.load(path);
+		std::filesystem::remove(path);
+
+		REQUIRE(ecs.hasEntity(entity)); // the id exists again, but it is a different entity
+		REQUIRE_FALSE(generations.isValid(handle));
+		REQUIRE_FALSE(generations.isValid(neverRemoved));
+		REQUIRE(generations.isValid(generations.getHandle(entity)));
+		REQUIRE(projectiles.empty());
+		events.damage.publish();
+		REQUIRE(events.damage.empty());
+	}
+
+	SECTION("Ids which were never removed are generation 0")
+	{
+		REQUIRE(generations.getGeneration(entity) == 0);
+		REQUIRE(generations.getGeneration(1000) == 0);
+	}
+}
@@ -0,0 +1,63 @@
+#include "../../src/modules/EventChannel.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace {
+struct TestEvent {
+	Easys::Entity entity = 0;
+	int value = 0;
+};
+} // namespace
+
+TEST_CASE("EventChannel Tests", "[EventChannel]")
+{
+	EventChannel<TestEvent> channel;
+	channel.push({3, 1});
+	channel.push({1, 2});
+	channel.push({3, 3});
+
+	SECTION("Events are only readable after publishing")
+	{
+		REQUIRE(channel.empty());
+		channel.publish();
+		REQUIRE(channel.size() == 3);
+
+		channel.push({2, 4});
+		REQUIRE(channel.size() == 3);
+		channel.publish();
+		REQUIRE(channel.size() == 1);
+		REQUIRE(channel.begin()->value == 4);
+
+		channel.publish();
+		REQUIRE(channel.empty());
+	}
+
+	SECTION("Published events are grouped by entity in push order")
+	{
+		const std::vector<TestEvent> more = {{2, 4}, {1, 5}};
+		channel.append(more.begin(), more.end());
+		channel.publish();
+
+		std::vector<Easys::Entity> entities;
+		std::vector<int> values;
+		channel.forEachEntity([&](const Easys::Entity entity, auto first, auto last) {
+			entities.push_back(entity);
+			for (auto it = first; it != last; ++it) {
+				REQUIRE(it->entity == entity);
+				values.push_back(it->value);
+			}
+		});
+
+		REQUIRE(entities == std::vector<Easys::Entity>{1, 2, 3});
+		REQUIRE(values == std::vector<int>{2, 5, 4, 1, 3});
+	}
+
+	SECTION("Clearing drops pending and published events")
+	{
+		channel.publish();
+		channel.push({1, 6});
+		channel.clear();
+		channel.publish();
+		REQUIRE(channel.empty());
+	}
+}
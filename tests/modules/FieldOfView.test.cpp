@@ -0,0 +1,90 @@
+#include "../../src/modules/FieldOfView.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("FieldOfView Tests", "[FieldOfView]")
+{
+	BitGrid grid(20, 20);
+	for (int y = 4; y < 15; y++) {
+		grid.set(12, y, true); // a wall east of the origin
+	}
+	const Vec2i origin{8, 10};
+
+	SECTION("Full circle")
+	{
+		FieldOfView fov;
+		fov.compute(grid, origin, 6, {0, -1}, 360);
+
+		REQUIRE(fov.isVisible(origin));
+		REQUIRE(fov.isVisible({8, 4}));        // straight up, at the edge of the radius
+		REQUIRE(fov.isVisible({2, 10}));       // straight left
+		REQUIRE_FALSE(fov.isVisible({8, 3}));  // out of range
+		REQUIRE_FALSE(fov.isVisible({3, 5}));  // out of range diagonally
+		REQUIRE(fov.isVisible({12, 10}));      // the wall itself
+		REQUIRE_FALSE(fov.isVisible({13, 10})); // behind the wall
+		REQUIRE_FALSE(fov.isVisible({50, 50}));
+	}
+
+	SECTION("Cone")
+	{
+		FieldOfView fov;
+		fov.compute(grid, origin, 6, {0, -1}, 90);
+
+		REQUIRE(fov.isVisible(origin));
+		REQUIRE(fov.isVisible({8, 5}));
+		REQUIRE(fov.isVisible({11, 7}));       // 45 degrees off
+		REQUIRE_FALSE(fov.isVisible({11, 8})); // more than 45 degrees off
+		REQUIRE_FALSE(fov.isVisible({8, 12})); // behind
+		REQUIRE_FALSE(fov.isVisible({4, 10})); // to the side
+	}
+
+	SECTION("Visible tiles are in range, in the cone and not behind the wall")
+	{
+		FieldOfView fov;
+		fov.compute(grid, origin, 8, {1, 0}, 180);
+
+		for (int y = 0; y < grid.getHeight(); y++) {
+			for (int x = 0; x < grid.getWidth(); x++) {
+				if (fov.isVisible({x, y})) {
+					const int dx = x - origin.x, dy = y - origin.y;
+					REQUIRE(dx * dx + dy * dy <= 8 * 8);
+					REQUIRE(dx >= 0);
+					REQUIRE((x <= 12 || y < 4 || y > 14));
+				}
+			}
+		}
+	}
+
+	SECTION("Without obstacles the field of view is exactly the cone")
+	{
+		const BitGrid empty(20, 20);
+		for (const Vec2f &forward : {Vec2f{0, 1}, Vec2f{-1, 0}, Vec2f{0.6f, 0.8f}}) {
+			for (float angle : {20.0f, 90.0f, 200.0f, 360.0f}) {
+				FieldOfView fov;
+				fov.compute(empty, origin, 7, forward, angle);
+				const ViewConeParams cone = ViewCone::makeParams({0, 0}, forward, 7, angle);
+
+				for (int y = 0; y < empty.getHeight(); y++) {
+					for (int x = 0; x < empty.getWidth(); x++) {
+						const Vec2f offset{float(x - origin.x), float(y - origin.y)};
+						const bool expected = Vec2i{x, y} == origin || ViewCone::isInside(cone, offset);
+						REQUIRE(fov.isVisible({x, y}) == expected);
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Recompute only when needed")
+	{
+		FieldOfView fov;
+		REQUIRE_FALSE(fov.isComputedFor(origin, 6, {0, -1}, 90));
+
+		fov.compute(grid, origin, 6, {0, -1}, 90);
+		REQUIRE(fov.isComputedFor(origin, 6, {0, -1}, 90));
+		REQUIRE_FALSE(fov.isComputedFor({8, 9}, 6, {0, -1}, 90));
+		REQUIRE_FALSE(fov.isComputedFor(origin, 6, {1, 0}, 90));
+
+		fov.invalidate();
+		REQUIRE_FALSE(fov.isComputedFor(origin, 6, {0, -1}, 90));
+	}
+}
@@ -0,0 +1,58 @@
+#include "../../src/modules/HitscanBatch.hpp"
+#include "../../src/modules/Utils.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("HitscanBatch Tests", "[HitscanBatch]")
+{
+	Easys::ECS ecs;
+	BitGrid impenetrable(20, 20);
+	HitscanBatch batch;
+
+	std::vector<Easys::Entity> colliders;
+	const auto addCollider = [&](const Vec2i &tile) {
+		colliders.push_back(ecs.addEntity());
+		ecs.addComponent<Positionable>(colliders.back(), Positionable{Utils::toFloat(tile * TILE_SIZE)});
+		return colliders.back();
+	};
+	const Easys::Entity shooter = addCollider({1, 1});
+	const Easys::Entity near = addCollider({5, 1});
+	const Easys::Entity far = addCollider({10, 1});
+	const Easys::Entity aside = addCollider({5, 8});
+
+	const Vec2f from{1.5f * TILE_SIZE, 1.5f * TILE_SIZE};
+	const Vec2f to{15.5f * TILE_SIZE, 1.5f * TILE_SIZE};
+
+	SECTION("Shots hit the first collider on their path, but not their shooter")
+	{
+		batch.add(HitscanShot{shooter, from, to, 10});
+		const std::vector<HitscanHit> &hits = batch.resolve(ecs, impenetrable, colliders);
+
+		REQUIRE(hits.size() == 1);
+		REQUIRE(hits[0].shooter == shooter);
+		REQUIRE(hits[0].target == near);
+		REQUIRE(hits[0].damage == 10);
+		REQUIRE(hits[0].position.x == Approx(5.0f * TILE_SIZE));
+		REQUIRE(batch.empty());
+	}
+
+	SECTION("Impenetrable tiles stop shots")
+	{
+		impenetrable.set(3, 1, true);
+		batch.add(HitscanShot{shooter, from, to, 10});
+		REQUIRE(batch.resolve(ecs, impenetrable, colliders).empty());
+	}
+
+	SECTION("Shots of a frame are resolved together")
+	{
+		batch.add(HitscanShot{near, {5.5f * TILE_SIZE, 1.5f * TILE_SIZE}, to, 1});
+		batch.add(HitscanShot{shooter, from, {1.5f * TILE_SIZE, 15.5f * TILE_SIZE}, 2});
+		batch.add(HitscanShot{shooter, from, {5.5f * TILE_SIZE, 8.5f * TILE_SIZE}, 3});
+		const std::vector<HitscanHit> &hits = batch.resolve(ecs, impenetrable, colliders);
+
+		REQUIRE(hits.size() == 2);
+		REQUIRE(hits[0].target == far);
+		REQUIRE(hits[1].target == aside);
+		REQUIRE(hits[1].damage == 3);
+	}
+}
@@ -0,0 +1,97 @@
+#include "../../src/modules/LineOfSight.hpp"
+#include <catch2/catch.hpp>
+
+BitGrid toBitGrid(const std::vector<std::vector<int>> &map)
+{
+	BitGrid grid(static_cast<int>(map[0].size()), static_cast<int>(map.size()));
+	for (int y = 0; y < grid.getHeight(); y++) {
+		for (int x = 0; x < grid.getWidth(); x++) {
+			grid.set(x, y, map[y][x] != 0);
+		}
+	}
+	return grid;
+}
+
+TEST_CASE("LineOfSight Tests", "[LineOfSight]")
+{
+	// clang-format off
+	const BitGrid grid = toBitGrid({
+		{0, 0, 0, 0, 0, 0},
+		{0, 0, 0, 0, 0, 0},
+		{0, 0, 1, 0, 0, 0},
+		{0, 0, 0, 0, 0, 0},
+		{0, 1, 0, 0, 0, 0},
+		{1, 0, 0, 0, 0, 0},
+	});
+	// clang-format on
+
+	SECTION("Axis aligned rays")
+	{
+		REQUIRE(LineOfSight::isVisible(grid, {0, 0}, {5, 0}));
+		REQUIRE(LineOfSight::isVisible(grid, {3, 5}, {3, 0}));
+		REQUIRE_FALSE(LineOfSight::isVisible(grid, {0, 2}, {5, 2}));
+		REQUIRE_FALSE(LineOfSight::isVisible(grid, {2, 0}, {2, 5}));
+	}
+
+	SECTION("Same tile and neighbours are always visible")
+	{
+		REQUIRE(LineOfSight::isVisible(grid, {1, 1}, {1, 1}));
+		REQUIRE(LineOfSight::isVisible(grid, {1, 2}, {2, 2})); // the blocking tile itself can be seen
+		REQUIRE(LineOfSight::isVisible(grid, {2, 2}, {3, 2})); // and can see out
+	}
+
+	SECTION("Diagonal rays and corners")
+	{
+		REQUIRE_FALSE(LineOfSight::isVisible(grid, {0, 0}, {4, 4})); // passes through (2, 2)
+		REQUIRE(LineOfSight::isVisible(grid, {1, 0}, {5, 4}));
+		REQUIRE_FALSE(LineOfSight::isVisible(grid, {0, 4}, {1, 5})); // corner sealed by (0, 5) and (1, 4)
+		REQUIRE(LineOfSight::isVisible(grid, {1, 2}, {2, 3}));       // one blocking tile does not seal the corner
+	}
+
+	SECTION("Is symmetric")
+	{
+		for (int y0 = 0; y0 < 6; y0++)
+			for (int x0 = 0; x0 < 6; x0++)
+				for (int y1 = 0; y1 < 6; y1++)
+					for (int x1 = 0; x1 < 6; x1++)
+						REQUIRE(LineOfSight::isVisible(grid, {x0, y0}, {x1, y1})
+						        == LineOfSight::isVisible(grid, {x1, y1}, {x0, y0}));
+	}
+
+	SECTION("Range and bounds")
+	{
+		REQUIRE(LineOfSight::isVisible(grid, {0, 0}, {5, 0}, 5));
+		REQUIRE_FALSE(LineOfSight::isVisible(grid, {0, 0}, {5, 1}, 5));
+		REQUIRE_FALSE(LineOfSight::isVisible(grid, {0, 0}, {6, 0}));
+		REQUIRE_FALSE(LineOfSight::isVisible(grid, {-1, 0}, {3, 0}));
+	}
+
+	SECTION("Batch matches single queries")
+	{
+		const std::vector<Vec2i> targets = {{5, 0}, {0, 5}, {4, 4}, {3, 1}, {1, 5}, {10, 10}, {0, 0}};
+		std::vector<std::uint8_t> result;
+		LineOfSight::isVisibleBatch(grid, {0, 0}, targets, result, 5);
+
+		REQUIRE(result.size() == targets.size());
+		for (std::size_t i = 0; i < targets.size(); i++) {
+			REQUIRE(static_cast<bool>(result[i]) == LineOfSight::isVisible(grid, {0, 0}, targets[i], 5));
+		}
+	}
+	SECTION("Segments in pixel space stop at the first blocked tile")
+	{
+		const auto isBlocked = [&grid](int x, int y) { return !grid.isInBounds(x, y) || grid.get(x, y); };
+
+		// enters the blocking tile (2, 2) at x = 20, an eighth of the way
+		const std::optional<float> hit = LineOfSight::traceSegment({10, 25}, {90, 25}, 10, isBlocked);
+		REQUIRE(hit);
+		REQUIRE(*hit == Approx(0.125f));
+
+		REQUIRE_FALSE(LineOfSight::traceSegment({10, 15}, {55, 15}, 10, isBlocked));
+		REQUIRE_FALSE(LineOfSight::traceSegment({32, 5}, {32, 5}, 10, isBlocked));
+		REQUIRE(LineOfSight::traceSegment({25, 25}, {40, 40}, 10, isBlocked) == 0.0f);
+		REQUIRE(LineOfSight::traceSegment({55, 5}, {75, 5}, 10, isBlocked) == Approx(0.25f)); // leaves the map
+
+		// a long diagonal step does not skip the blocking tile (1, 4) it passes through
+		REQUIRE(LineOfSight::traceSegment({5, 55}, {25, 35}, 10, isBlocked));
+	}
+}
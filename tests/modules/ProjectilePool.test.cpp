@@ -0,0 +1,40 @@
+#include "../../src/modules/ProjectilePool.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("ProjectilePool Tests", "[ProjectilePool]")
+{
+	ProjectilePool pool;
+	pool.spawn({0, 0}, {10, 0}, 100, 1, 1, 0);
+	pool.spawn({1, 1}, {0, 10}, 200, 2, 2, 0);
+	pool.spawn({2, 2}, {-10, 0}, 300, 3, 3, 0);
+
+	SECTION("Spawning appends to all arrays")
+	{
+		REQUIRE(pool.size() == 3);
+		REQUIRE(pool.getPosition(1) == Vec2f{1, 1});
+		REQUIRE(pool.velocityY[1] == 10);
+		REQUIRE(pool.startX[2] == 2);
+		REQUIRE(pool.range[2] == 300);
+		REQUIRE(pool.shooter.size() == 3);
+	}
+
+	SECTION("Removing moves the last projectile into the gap")
+	{
+		pool.remove(0);
+		REQUIRE(pool.size() == 2);
+		REQUIRE(pool.getPosition(0) == Vec2f{2, 2});
+		REQUIRE(pool.velocityX[0] == -10);
+		REQUIRE(pool.range[0] == 300);
+		REQUIRE(pool.damage[0] == 3);
+		REQUIRE(pool.shooter[0] == 3);
+		REQUIRE(pool.shooter[1] == 2);
+	}
+
+	SECTION("Removing the last projectile")
+	{
+		pool.remove(2);
+		pool.remove(1);
+		pool.remove(0);
+		REQUIRE(pool.empty());
+	}
+}
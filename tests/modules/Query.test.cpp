@@ -0,0 +1,82 @@
+#include "../../src/components/Controllable.hpp"
+#include "../../src/components/Health.hpp"
+#include "../../src/modules/CommandBuffer.hpp"
+#include "../../src/modules/Query.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("Query Tests", "[Query]")
+{
+	Easys::ECS ecs;
+	QueryRegistry queries(ecs);
+	CommandBuffer commandBuffer(queries);
+
+	std::vector<Easys::Entity> entities;
+	for (int i = 0; i < 4; i++) {
+		entities.push_back(ecs.addEntity());
+		ecs.addComponent<Health>(entities.back(), Health{i});
+	}
+	ecs.addComponent<Controllable>(entities[1], Controllable{});
+	ecs.addComponent<Controllable>(entities[3], Controllable{});
+
+	SECTION("Queries contain the entities with all components")
+	{
+		Query<Health, Controllable> &query = queries.get<Health, Controllable>();
+		REQUIRE(query.size() == 2);
+		REQUIRE(query.contains(entities[1]));
+		REQUIRE(query.contains(entities[3]));
+		REQUIRE_FALSE(query.contains(entities[0]));
+	}
+
+	SECTION("Queries for the same components are shared")
+	{
+		REQUIRE(&queries.get<Health>() == &queries.get<Health>());
+		REQUIRE(queries.get<Health>().size() == 4);
+	}
+
+	SECTION("Playback keeps queries up to date")
+	{
+		Query<Health, Controllable> &query = queries.get<Health, Controllable>();
+		commandBuffer.addComponent<Controllable>(entities[0], Controllable{});
+		commandBuffer.removeComponent<Health>(entities[1]);
+		commandBuffer.removeEntity(entities[3]);
+		commandBuffer.playback(ecs);
+
+		REQUIRE(query.size() == 1);
+		REQUIRE(query.contains(entities[0]));
+		REQUIRE(queries.get<Health>().size() == 2);
+	}
+
+	SECTION("Entities are iterated in ascending order")
+	{
+		Query<Health> &query = queries.get<Health>();
+		commandBuffer.removeEntity(entities[1]);
+		commandBuffer.playback(ecs);
+		const Easys::Entity entity = ecs.addEntity();
+		commandBuffer.addComponent<Health>(entity, Health{4});
+		commandBuffer.playback(ecs);
+
+		std::vector<Easys::Entity> iterated(query.begin(), query.end());
+		REQUIRE(std::is_sorted(iterated.begin(), iterated.end()));
+		REQUIRE(iterated.size() == 4);
+	}
+
+	SECTION("forEach passes the components")
+	{
+		int sum = 0;
+		queries.get<Health, Controllable>().forEach(
+		    [&](const Easys::Entity, Health &health, Controllable &) { sum += health.health; });
+		REQUIRE(sum == 4);
+	}
+
+	SECTION("Rebuild picks up direct changes")
+	{
+		Query<Controllable> &query = queries.get<Controllable>();
+		ecs.addComponent<Controllable>(entities[2], Controllable{});
+		REQUIRE(query.size() == 2);
+
+		queries.rebuild();
+		REQUIRE(query.size() == 3);
+	}
+}
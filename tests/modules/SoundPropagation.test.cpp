@@ -0,0 +1,49 @@
+#include "../../src/modules/SoundPropagation.hpp"
+#include <catch2/catch.hpp>
+
+TEST_CASE("SoundPropagation Tests", "[SoundPropagation]")
+{
+	BitGrid grid(10, 10);
+	for (int y = 0; y < 9; y++) {
+		grid.set(5, y, true); // a wall with a gap at the bottom
+	}
+	SoundPropagation propagation(30);
+
+	SECTION("Open ground")
+	{
+		REQUIRE(propagation.getDistance(grid, {1, 1}, {1, 1}) == 0);
+		REQUIRE(propagation.getDistance(grid, {1, 1}, {4, 1}) == 3);
+		REQUIRE(propagation.getDistance(grid, {1, 1}, {3, 4}) == 5);
+	}
+
+	SECTION("Sound goes around or through walls, whichever is cheaper")
+	{
+		// through the wall: one step, the wall tile and one step
+		REQUIRE(propagation.getDistance(grid, {3, 1}, {6, 1}) == 1 + SoundPropagation::WALL_DAMPENING + 1);
+		// around the wall through the gap
+		REQUIRE(propagation.getDistance(grid, {4, 8}, {6, 8}) == 4);
+	}
+
+	SECTION("Range limit")
+	{
+		SoundPropagation shortRange(3);
+		REQUIRE(shortRange.getDistance(grid, {0, 9}, {3, 9}) == 3);
+		REQUIRE(shortRange.getDistance(grid, {0, 9}, {4, 9}) == SoundPropagation::UNREACHABLE);
+		REQUIRE(shortRange.getDistance(grid, {0, 9}, {20, 9}) == SoundPropagation::UNREACHABLE);
+	}
+
+	SECTION("Fields are cached per source tile")
+	{
+		const auto &field = propagation.getDistanceField(grid, {2, 2});
+		REQUIRE(&propagation.getDistanceField(grid, {2, 2}) == &field);
+		REQUIRE(propagation.getCacheSize() == 1);
+
+		for (int i = 0; i < 100; i++) {
+			propagation.getDistance(grid, {i % 10, i / 10}, {0, 0});
+		}
+		REQUIRE(propagation.getCacheSize() == SoundPropagation::MAX_CACHED_FIELDS);
+
+		propagation.clear();
+		REQUIRE(propagation.getCacheSize() == 0);
+	}
+}
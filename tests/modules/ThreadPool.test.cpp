@@ -0,0 +1,43 @@
+#include "../../src/modules/ThreadPool.hpp"
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <vector>
+
+TEST_CASE("ThreadPool Tests", "[ThreadPool]")
+{
+	ThreadPool pool(4);
+	REQUIRE(pool.getThreadCount() == 4);
+
+	SECTION("Every index is run exactly once")
+	{
+		for (const std::size_t count : {0, 1, 3, 100, 1000}) {
+			std::vector<std::atomic<int>> calls(count);
+			std::atomic<bool> validThreadIndices = true;
+
+			pool.parallelFor(count, [&](std::size_t index, std::size_t threadIndex) {
+				calls[index]++;
+				if (threadIndex >= pool.getThreadCount())
+					validThreadIndices = false;
+			});
+
+			REQUIRE(validThreadIndices);
+			for (const std::atomic<int> &call : calls) {
+				REQUIRE(call == 1);
+			}
+		}
+	}
+
+	SECTION("Per-thread buffers need no synchronization")
+	{
+		std::vector<long long> sums(pool.getThreadCount(), 0);
+		for (int job = 0; job < 50; job++) {
+			pool.parallelFor(1000, [&](std::size_t index, std::size_t threadIndex) { sums[threadIndex] += index; });
+		}
+
+		long long total = 0;
+		for (const long long sum : sums) {
+			total += sum;
+		}
+		REQUIRE(total == 50LL * 999 * 1000 / 2);
+	}
+}
@@ -0,0 +1,66 @@
+#include "../../src/modules/ViewCone.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <random>
+
+// The original acos based test, used as a reference.
+bool isWithinViewConeReference(const Vec2f &source, const Vec2f &target, const Vec2f &forward, float range, float angle)
+{
+	Vec2f toEntity = target - source;
+	if (toEntity.length() > range)
+		return false;
+
+	float dotProduct = forward.norm().dot(toEntity.norm());
+	float angleToEntity = std::acos(dotProduct) * (180.0f / (float)M_PI);
+	return angleToEntity <= (angle / 2);
+}
+
+TEST_CASE("ViewCone Tests", "[ViewCone]")
+{
+	const Vec2f origin{320, 320};
+
+	SECTION("Range and angle")
+	{
+		const ViewConeParams cone = ViewCone::makeParams(origin, {1, 0}, 100, 90);
+
+		REQUIRE(ViewCone::isInside(cone, {400, 320}));       // straight ahead
+		REQUIRE(ViewCone::isInside(cone, {380, 370}));       // 40 degrees off
+		REQUIRE_FALSE(ViewCone::isInside(cone, {421, 320})); // out of range
+		REQUIRE_FALSE(ViewCone::isInside(cone, {360, 380})); // 56 degrees off
+		REQUIRE_FALSE(ViewCone::isInside(cone, {250, 320})); // behind
+	}
+
+	SECTION("Cones wider than 180 degrees")
+	{
+		const ViewConeParams cone = ViewCone::makeParams(origin, {0, 1}, 100, 270);
+
+		REQUIRE(ViewCone::isInside(cone, {380, 300}));       // slightly behind to the side
+		REQUIRE_FALSE(ViewCone::isInside(cone, {320, 250})); // directly behind
+	}
+
+	SECTION("Batch matches the reference for every lane and the scalar tail")
+	{
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> distribution(0.0f, 640.0f);
+
+		ViewConeCandidates candidates;
+		for (int i = 0; i < 1003; i++) {
+			candidates.push_back({distribution(generator), distribution(generator)});
+		}
+
+		for (float angle : {60.0f, 180.0f, 300.0f}) {
+			const Vec2f forward{0, -1};
+			const ViewConeParams cone = ViewCone::makeParams(origin, forward, 20 * TILE_SIZE / 2, angle);
+			std::vector<std::uint8_t> mask;
+			ViewCone::testBatch(cone, candidates, mask);
+
+			REQUIRE(mask.size() == candidates.size());
+			for (std::size_t i = 0; i < candidates.size(); i++) {
+				const Vec2f target{candidates.x[i], candidates.y[i]};
+				REQUIRE(static_cast<bool>(mask[i]) == ViewCone::isInside(cone, target));
+				REQUIRE(ViewCone::isInside(cone, target)
+				        == isWithinViewConeReference(origin, target, forward, 20 * TILE_SIZE / 2, angle));
+			}
+		}
+	}
+}